@@ -1,23 +1,80 @@
 #pragma once
 
 #include <type_traits>
+#include <atomic>
 #include <tuple>
 #include <memory>
 #include <unordered_map>
+#include <algorithm>
 #include <any>
+#include <array>
+#include <bit>
+#include <deque>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cctype>
+#include <condition_variable>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <fstream>
 #include <functional>
+#include <future>
 #include <iostream>
 #include <expected>
 #include <iomanip>
 #include <map>
 #include <mutex>
-
-#include <cxxabi.h>
+#include <memory_resource>
+#include <new>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#if defined(__unix__) or defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "jmixin/jstring.h"
 #include "jmixin/jstringliteral.h"
 
+/*
+ * when set, SINGLE bindings are deferred like DEFERRED_SINGLE ones and
+ * constructed on their first resolution.
+ */
+#ifndef JINJECT_DEFERRED_SINGLE
+#define JINJECT_DEFERRED_SINGLE 0
+#endif
+
+/*
+ * when set, resolutions and constructions of each binding are counted and
+ * timed (see metrics()); otherwise the probes compile to nothing.
+ */
+#ifndef JINJECT_METRICS
+#define JINJECT_METRICS 0
+#endif
+
+/*
+ * when set, a running jinject::trace records the resolutions and their
+ * nesting; otherwise the probes compile to nothing.
+ */
+#ifndef JINJECT_TRACE
+#define JINJECT_TRACE 0
+#endif
+
+#ifndef JINJECT_MAX_LOCALES
+#define JINJECT_MAX_LOCALES 32
+#endif
+
 namespace jinject {
     template<typename T>
     concept SharedPtrConcept = std::same_as<std::shared_ptr<typename T::element_type>, T>;
@@ -37,27 +94,363 @@ namespace jinject {
     enum instantiation_mode {
         UNKNOWN,
         SINGLE,
-        FACTORY
+        FACTORY,
+        SCOPED,
+        DEFERRED,
+        THREAD,
+        SHARDED
     };
 
     namespace details {
+        /*
+         * Type erased, non allocating replacement of std::function<T()> for
+         * binding callbacks: the functor is stored in place when it fits in
+         * the slot (the common case of lambdas capturing a few values) and is
+         * invoked through a plain function pointer, whose body is the inlined
+         * functor call.
+         */
+        template<typename T>
+        struct callable {
+            static constexpr std::size_t capacity = 4*sizeof(void *);
+
+            constexpr callable() = default;
+
+            callable(callable const &) = delete;
+
+            callable(callable &&) = delete;
+
+            ~callable() {
+                reset();
+            }
+
+            template<typename Callback>
+            void assign(Callback &&callback) {
+                using functor = std::decay_t<Callback>;
+
+                reset();
+
+                if constexpr (sizeof(functor) <= capacity and alignof(functor) <= alignof(std::max_align_t)) {
+                    ::new(static_cast<void *>(mStorage)) functor(std::forward<Callback>(callback));
+
+                    mInvoke = [](void *storage) -> T {
+                        return (*std::launder(static_cast<functor *>(storage)))();
+                    };
+
+                    mDestroy = [](void *storage) {
+                        std::launder(static_cast<functor *>(storage))->~functor();
+                    };
+                } else {
+                    ::new(static_cast<void *>(mStorage)) functor *(new functor(std::forward<Callback>(callback)));
+
+                    mInvoke = [](void *storage) -> T {
+                        return (**std::launder(static_cast<functor **>(storage)))();
+                    };
+
+                    mDestroy = [](void *storage) {
+                        delete *std::launder(static_cast<functor **>(storage));
+                    };
+                }
+            }
+
+            void reset() {
+                if (mDestroy) {
+                    mDestroy(mStorage);
+                }
+
+                mInvoke = nullptr;
+                mDestroy = nullptr;
+            }
+
+            T operator()() const {
+                return mInvoke(mStorage);
+            }
+
+            explicit operator bool() const {
+                return mInvoke != nullptr;
+            }
+
+        private:
+            alignas(std::max_align_t) mutable unsigned char mStorage[capacity] {};
+            T (*mInvoke)(void *) = nullptr;
+            void (*mDestroy)(void *) = nullptr;
+        };
+
+        /*
+         * multiple binds of T, one entry per signature kept in resolution
+         * order: higher priority first and, among equal priorities, in the
+         * order they were first registered.
+         */
         template<typename T>
         struct all_binds {
-            inline static std::vector<std::function<T()> > mCallbacks;
+            struct entry {
+                void const *key;
+                int priority;
+                T (*callback)();
+            };
+
+            inline static std::vector<entry> mBinds;
+            inline static std::vector<T (*)()> mCallbacks;
+            inline static std::mutex mMutex;
+
+            static void add(void const *key, int priority, T (*callback)()) {
+                std::lock_guard lock{mMutex};
+
+                auto item = std::find_if(mBinds.begin(), mBinds.end(),
+                                         [&](auto const &bind) {
+                                             return bind.key == key;
+                                         });
+
+                if (item != mBinds.end() and item->priority == priority) {
+                    item->callback = callback;
+                } else {
+                    if (item != mBinds.end()) {
+                        mBinds.erase(item);
+                    }
+
+                    auto position = std::find_if(mBinds.begin(), mBinds.end(),
+                                                 [&](auto const &bind) {
+                                                     return bind.priority < priority;
+                                                 });
+
+                    mBinds.insert(position, entry{key, priority, callback});
+                }
+
+                mCallbacks.clear();
+
+                for (auto const &bind: mBinds) {
+                    mCallbacks.push_back(bind.callback);
+                }
+            }
+
+            static std::vector<T (*)()> snapshot() {
+                std::lock_guard lock{mMutex};
+
+                return mCallbacks;
+            }
+        };
+    }
+
+    /*
+     * order of a bind in all{} and all_view<T>; specialize it to move a
+     * binding ahead (higher values) or behind (lower values) of the others.
+     *
+     * template<>
+     * struct binding_priority<IPlugin *, MainPlugin> : std::integral_constant<int, 10> {
+     * };
+     */
+    template<typename T, typename... Signature>
+    struct binding_priority : std::integral_constant<int, 0> {
+    };
+
+    enum execution_mode {
+        SEQUENTIAL,
+        PARALLEL
+    };
+
+    namespace details {
+        /*
+         * threads kept for the whole process to run the parallel work of
+         * all{PARALLEL} and warmup::run(); the pool grows to the largest number
+         * of workers requested and never shrinks.
+         */
+        class thread_pool {
+        public:
+            static thread_pool & instance() {
+                static thread_pool pool;
+
+                return pool;
+            }
+
+            thread_pool(thread_pool const &) = delete;
+
+            thread_pool(thread_pool &&) = delete;
+
+            ~thread_pool() {
+                {
+                    std::lock_guard lock{mMutex};
 
-            static void add(std::function<T()> callback) {
-                mCallbacks.push_back(callback);
+                    mStop = true;
+                }
+
+                mCondition.notify_all();
+            }
+
+            void reserve(std::size_t workers) {
+                std::lock_guard lock{mMutex};
+
+                while (mThreads.size() < workers) {
+                    mThreads.emplace_back([this]() {
+                        run();
+                    });
+                }
+            }
+
+            void post(std::function<void()> task) {
+                {
+                    std::lock_guard lock{mMutex};
+
+                    mTasks.push_back(std::move(task));
+                }
+
+                mCondition.notify_one();
+            }
+
+        private:
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+            std::deque<std::function<void()> > mTasks;
+            bool mStop{false};
+            std::vector<std::jthread> mThreads;
+
+            thread_pool() = default;
+
+            void run() {
+                for (;;) {
+                    std::unique_lock lock{mMutex};
+
+                    mCondition.wait(lock, [this]() {
+                        return mStop or not mTasks.empty();
+                    });
+
+                    if (mTasks.empty()) {
+                        return;
+                    }
+
+                    auto task = std::move(mTasks.front());
+
+                    mTasks.pop_front();
+
+                    lock.unlock();
+
+                    task();
+                }
             }
         };
+
+        /*
+         * runs callback(0) ... callback(count - 1) on up to workers threads,
+         * the calling one and the ones of the thread_pool; the first exception
+         * thrown by a callback is rethrown once every worker has finished. The
+         * caller takes part in the work, and helpers that start after it is
+         * done just leave, so nested calls from pool threads cannot deadlock.
+         */
+        template<typename Callback>
+        void parallel_for(std::size_t count, Callback &&callback, std::size_t workers = std::thread::hardware_concurrency()) {
+            workers = std::min(count, std::max<std::size_t>(workers, 1));
+
+            if (workers <= 1) {
+                for (std::size_t i = 0; i < count; i++) {
+                    callback(i);
+                }
+
+                return;
+            }
+
+            struct state {
+                std::atomic<std::size_t> next{0};
+                std::size_t count;
+                std::function<void(std::size_t)> callback;
+                std::exception_ptr error;
+                std::mutex mutex;
+                std::condition_variable condition;
+                std::size_t active{0};
+                bool closed{false};
+
+                void work() {
+                    for (auto i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+                         i = next.fetch_add(1, std::memory_order_relaxed)) {
+                        try {
+                            callback(i);
+                        } catch (...) {
+                            std::lock_guard lock{mutex};
+
+                            if (!error) {
+                                error = std::current_exception();
+                            }
+                        }
+                    }
+                }
+            };
+
+            auto shared = std::make_shared<state>();
+
+            shared->count = count;
+            shared->callback = [&callback](std::size_t i) {
+                callback(i);
+            };
+
+            auto &pool = thread_pool::instance();
+
+            pool.reserve(workers - 1);
+
+            for (std::size_t i = 1; i < workers; i++) {
+                pool.post([shared]() {
+                    {
+                        std::lock_guard lock{shared->mutex};
+
+                        if (shared->closed) {
+                            return;
+                        }
+
+                        shared->active++;
+                    }
+
+                    shared->work();
+
+                    {
+                        std::lock_guard lock{shared->mutex};
+
+                        shared->active--;
+                    }
+
+                    shared->condition.notify_all();
+                });
+            }
+
+            shared->work();
+
+            {
+                std::unique_lock lock{shared->mutex};
+
+                shared->closed = true;
+
+                shared->condition.wait(lock, [&]() {
+                    return shared->active == 0;
+                });
+            }
+
+            if (shared->error) {
+                std::rethrow_exception(shared->error);
+            }
+        }
     }
 
     struct all {
+        all(execution_mode mode = SEQUENTIAL)
+            : mMode{mode} {
+        }
+
         template<typename T, template <typename...> class Container>
         operator Container<T>() {
-            auto &callbacks = details::all_binds<T>::mCallbacks;
+            auto callbacks = details::all_binds<T>::snapshot();
 
             Container<T> result;
 
+            if (mMode == PARALLEL) {
+                std::vector<std::optional<T> > values(callbacks.size());
+
+                details::parallel_for(callbacks.size(),
+                                      [&](std::size_t i) {
+                                          values[i].emplace(callbacks[i]());
+                                      });
+
+                for (auto &value: values) {
+                    result.insert(result.end(), std::move(*value));
+                }
+
+                return result;
+            }
+
             std::transform(callbacks.begin(), callbacks.end(), std::back_inserter(result),
                            [](auto &&value) {
                                return value();
@@ -65,233 +458,2519 @@ namespace jinject {
 
             return result;
         }
+
+    private:
+        execution_mode mMode;
     };
 
-    struct named {
-        named(std::string const &id, auto const &value) {
-            if (sNames.find(id) != sNames.end()) {
-                throw std::runtime_error(std::string("Name") + " '" + id + "' already defined");
-            }
+    /*
+     * lazy range over the multiple binds of T: an instance is only created
+     * when its iterator is dereferenced, and kept by the iterator until it
+     * is incremented.
+     */
+    template<typename T>
+    struct all_view {
+        struct iterator {
+            using iterator_category = std::input_iterator_tag;
+            using value_type = T;
+            using difference_type = std::ptrdiff_t;
 
-            sNames[id] = std::to_string(value);
-        }
+            iterator() = default;
 
-        named(std::string const &id, char const *value) {
-            if (sNames.find(id) != sNames.end()) {
-                throw std::runtime_error(std::string("Name") + " '" + id + "' already defined");
+            iterator(typename std::vector<T (*)()>::const_iterator current)
+                : mCurrent{current} {
             }
 
-            sNames[id] = value;
-        }
-
-        inline static std::map<std::string, jmixin::String> sNames;
-    };
-
-    template<jmixin::StringLiteral ID>
-    struct get_named {
-        get_named(std::string const &value = "")
-            : mDefault{value} {
-        }
+            T & operator*() const {
+                if (!mValue) {
+                    mValue.emplace((*mCurrent)());
+                }
 
-        std::expected<int32_t, std::string> get_int() {
-            try {
-                return std::stoi(get_string().value_or(""));
-            } catch (std::invalid_argument &e) {
-                // logt
-            } catch (std::out_of_range &e) {
-                // logt
+                return *mValue;
             }
 
-            return std::unexpected{"unable to convert named value to 'int'"};
-        }
+            iterator & operator++() {
+                mCurrent++;
+                mValue.reset();
 
-        std::expected<int64_t, std::string> get_long() {
-            try {
-                return std::stoll(get_string().value_or(""));
-            } catch (std::invalid_argument &e) {
-                // logt
-            } catch (std::out_of_range &e) {
-                // logt
+                return *this;
             }
 
-            return std::unexpected{"unable to convert named value to 'long'"};
-        }
-
-        std::expected<float, std::string> get_float() {
-            try {
-                return std::stof(get_string().value_or(""));
-            } catch (std::invalid_argument &e) {
-                // logt
-            } catch (std::out_of_range &e) {
-                // logt
+            void operator++(int) {
+                ++*this;
             }
 
-            return std::unexpected{"unable to convert named value to 'float'"};
-        }
-
-        std::expected<double, std::string> get_double() {
-            try {
-                return std::stod(get_string().value_or(""));
-            } catch (std::invalid_argument &e) {
-                // logt
-            } catch (std::out_of_range &e) {
-                // logt
+            bool operator==(iterator const &other) const {
+                return mCurrent == other.mCurrent;
             }
 
-            return std::unexpected{"unable to convert named value to 'double'"};
-        }
-
-        std::expected<jmixin::String, std::string> get_string() {
-            auto item = named::sNames.find(ID.to_string());
-
-            if (item != named::sNames.end()) {
-                return {item->second};
-            }
+        private:
+            typename std::vector<T (*)()>::const_iterator mCurrent;
+            mutable std::optional<T> mValue;
+        };
 
-            return std::unexpected{"no return registered"};
+        all_view()
+            : mCallbacks{details::all_binds<T>::snapshot()} {
         }
 
-        template<typename... Args>
-        jmixin::String format(Args... args) {
-            return get_string().value_or(mDefault).format(args...);
+        iterator begin() const {
+            return {mCallbacks.begin()};
         }
 
-        operator std::string() {
-            return get_string().value_or(mDefault);
+        iterator end() const {
+            return {mCallbacks.end()};
         }
 
-        operator jmixin::String() {
-            return get_string().value_or(mDefault);
+        std::size_t size() const {
+            return mCallbacks.size();
         }
 
     private:
-        jmixin::String mDefault;
+        std::vector<T (*)()> mCallbacks;
     };
 
-    template<jmixin::StringLiteral TEXT>
-    struct typed {
-        typed() {
-            if (sNames.find(-1) != sNames.end()) {
-                throw std::runtime_error(std::string("Name") + " '" + TEXT.to_string() + "' already defined");
+    namespace details {
+        struct BorrowedType {
+        };
+
+        /*
+         * value of a NAMED binding: numeric forms are converted once at
+         * registration, so the typed getters only test a flag, and the string
+         * form of numeric values is produced on the first request.
+         */
+        struct named_value {
+            enum kind : uint8_t {
+                INT = 1 << 0,
+                LONG = 1 << 1,
+                FLOAT = 1 << 2,
+                DOUBLE = 1 << 3
+            };
+
+            named_value(named_value const &) = delete;
+
+            named_value(named_value &&) = delete;
+
+            explicit named_value(std::string_view text)
+                : mString{std::string{text}}, mText{mString} {
+                parse();
             }
 
-            sNames[-1] = TEXT.to_string();
-        }
+            /*
+             * value whose text is owned by someone else (a mapped file) and
+             * outlives it, so it is neither copied nor released.
+             */
+            named_value(BorrowedType, std::string_view text)
+                : mText{text} {
+                parse();
+            }
 
-        typed & add(std::size_t id, std::string_view value) {
-			sNames[id] = std::string{value};
+            template<typename T>
+                requires (std::is_arithmetic_v<T>)
+            explicit named_value(T value)
+                : mNumeric{true} {
+                if constexpr (std::is_floating_point_v<T>) {
+                    mRender = [](named_value const &self) {
+                        return std::to_string(self.mDouble);
+                    };
 
-            return *this;
-        }
+                    store_floating(value);
 
-        inline static std::map<int, jmixin::String> sNames;
-    };
+                    if (value >= static_cast<double>(std::numeric_limits<int64_t>::min()) and
+                        value < static_cast<double>(std::numeric_limits<int64_t>::max())) {
+                        store_integer(static_cast<int64_t>(value));
+                    }
+                } else if constexpr (std::is_unsigned_v<T>) {
+                    mUnsigned = value;
 
-    template<jmixin::StringLiteral TEXT, int INDEX = -1>
-    struct get_typed {
-        get_typed() = default;
+                    mRender = [](named_value const &self) {
+                        return std::to_string(self.mUnsigned);
+                    };
 
-        operator std::string() {
-            auto item = typed<TEXT>::sNames.find(INDEX);
+                    if (value <= static_cast<std::make_unsigned_t<int64_t>>(std::numeric_limits<int64_t>::max())) {
+                        store_integer(static_cast<int64_t>(value));
+                    }
+
+                    store_floating(static_cast<double>(value));
+                } else {
+                    mRender = [](named_value const &self) {
+                        return std::to_string(self.mLong);
+                    };
 
-            if (item != typed<TEXT>::sNames.end()) {
-				return item->second;
+                    store_integer(static_cast<int64_t>(value));
+                    store_floating(static_cast<double>(value));
+                }
             }
 
-			return TEXT.to_string();
-        }
-    };
+            template<typename T>
+            T const * as() const {
+                if constexpr (std::is_same_v<T, int32_t>) {
+                    return (mKinds & INT) ? &mInt : nullptr;
+                } else if constexpr (std::is_same_v<T, int64_t>) {
+                    return (mKinds & LONG) ? &mLong : nullptr;
+                } else if constexpr (std::is_same_v<T, float>) {
+                    return (mKinds & FLOAT) ? &mFloat : nullptr;
+                } else if constexpr (std::is_same_v<T, double>) {
+                    return (mKinds & DOUBLE) ? &mDouble : nullptr;
+                } else {
+                    static_assert(sizeof(T) == 0, "jinject::unsupported named value type");
+                }
+            }
 
-    template<typename... Signature>
-    struct get;
+            std::string_view text() const {
+                if (mNumeric) {
+                    std::call_once(mFlag,
+                                   [this]() {
+                                       mString = mRender(*this);
+                                       mText = mString;
+                                   });
+                }
 
-    namespace details {
-        template<typename T, typename... Signature>
-        struct bind {
-            bind() {
-                auto callback = []() {
-                    return static_cast<T>(get<Signature...>{});
-                };
+                return mText;
+            }
+
+        private:
+            mutable std::once_flag mFlag;
+            mutable jmixin::String mString;
+            mutable std::string_view mText;
+            std::string (*mRender)(named_value const &) = nullptr;
+            bool mNumeric{false};
+            uint8_t mKinds{0};
+            int32_t mInt{0};
+            int64_t mLong{0};
+            uint64_t mUnsigned{0};
+            float mFloat{0.0f};
+            double mDouble{0.0};
+
+            void parse() {
+                auto first = mText.data();
+                auto last = first + mText.size();
+
+                while (first != last and std::isspace(static_cast<unsigned char>(*first))) {
+                    first++;
+                }
+
+                if (first != last and *first == '+') {
+                    first++;
+                }
 
-                details::all_binds<T>::add(callback);
+                int64_t integer;
+
+                if (std::from_chars(first, last, integer).ec == std::errc{}) {
+                    store_integer(integer);
+                }
+
+                double floating;
+
+                if (std::from_chars(first, last, floating).ec == std::errc{}) {
+                    store_floating(floating);
+                }
             }
-        };
 
-        template<typename T, typename... Signature>
-        struct instantiation : public bind<T, Signature...> {
-            using type = std::remove_cvref_t<T>;
+            void store_integer(int64_t value) {
+                mLong = value;
+                mKinds |= LONG;
 
-            static inline instantiation_mode mode = UNKNOWN;
+                if (value >= std::numeric_limits<int32_t>::min() and value <= std::numeric_limits<int32_t>::max()) {
+                    mInt = static_cast<int32_t>(value);
+                    mKinds |= INT;
+                }
+            }
 
-            instantiation(): bind<T, Signature...>() {
-                if (mode != UNKNOWN) {
-                    throw std::runtime_error("jinject::instantiation already defined");
+            void store_floating(double value) {
+                mDouble = value;
+                mKinds |= DOUBLE;
+
+                if (not std::isfinite(value) or std::abs(value) <= std::numeric_limits<float>::max()) {
+                    mFloat = static_cast<float>(value);
+                    mKinds |= FLOAT;
                 }
             }
         };
+    }
+
+    namespace details {
+        /*
+         * contents of a key=value file mapped for the life of the named_file and
+         * indexed, in one pass, into an open addressing table of views into
+         * the mapping. Lines may be "key = value", "export KEY=value" or
+         * "[section]" headers, whose keys are then named "section.key"; values
+         * may be quoted and lines starting with '#' or ';' are comments. A key
+         * defined twice keeps its last value.
+         */
+        struct named_file {
+            explicit named_file(std::string const &path)
+                : mContent{map(path)} {
+                std::size_t lines = std::count(mContent.begin(), mContent.end(), '\n') + 1;
+
+                mSlots.resize(std::bit_ceil(2*lines));
+
+                std::string_view section;
+
+                for (std::size_t start = 0; start < mContent.size();) {
+                    auto end = mContent.find('\n', start);
+
+                    if (end == std::string_view::npos) {
+                        end = mContent.size();
+                    }
+
+                    auto line = trim(mContent.substr(start, end - start));
+
+                    start = end + 1;
+
+                    if (line.empty() or line.front() == '#' or line.front() == ';') {
+                        continue;
+                    }
+
+                    if (line.front() == '[' and line.back() == ']') {
+                        section = trim(line.substr(1, line.size() - 2));
+
+                        continue;
+                    }
+
+                    if (line.starts_with("export") and line.size() > 6 and std::isspace(static_cast<unsigned char>(line[6]))) {
+                        line = trim(line.substr(6));
+                    }
+
+                    auto separator = line.find('=');
+
+                    if (separator == std::string_view::npos) {
+                        continue;
+                    }
+
+                    auto key = trim(line.substr(0, separator));
+                    auto value = trim(line.substr(separator + 1));
+
+                    if (value.size() >= 2 and (value.front() == '"' or value.front() == '\'') and value.back() == value.front()) {
+                        value = value.substr(1, value.size() - 2);
+                    }
+
+                    if (not key.empty()) {
+                        insert(section, key, value);
+                    }
+                }
+            }
+
+            named_file(named_file const &) = delete;
+
+            named_file(named_file &&) = delete;
+
+            ~named_file() {
+#if defined(__unix__) or defined(__APPLE__)
+                if (not mContent.empty()) {
+                    ::munmap(const_cast<char *>(mContent.data()), mContent.size());
+                }
+#endif
+            }
+
+            std::size_t size() const {
+                return mSize;
+            }
+
+            /*
+             * value of id, promoted to a named_value viewing the mapping on
+             * its first request; callers serialize the calls.
+             */
+            named_value const * find(std::string_view id) {
+                auto mask = mSlots.size() - 1;
+
+                for (auto i = hash({}, id) & mask; mSlots[i].key.data() != nullptr; i = (i + 1) & mask) {
+                    auto &slot = mSlots[i];
+
+                    if (slot.matches(id)) {
+                        if (slot.value == nullptr) {
+                            slot.value = &mValues.emplace_back(BorrowedType{}, slot.text);
+                        }
+
+                        return slot.value;
+                    }
+                }
+
+                return nullptr;
+            }
+
+        private:
+            struct slot {
+                std::string_view section;
+                std::string_view key;
+                std::string_view text;
+                named_value const *value{nullptr};
+
+                bool matches(std::string_view id) const {
+                    if (section.empty()) {
+                        return id == key;
+                    }
+
+                    return id.size() == section.size() + 1 + key.size() and id.starts_with(section) and
+                        id[section.size()] == '.' and id.ends_with(key);
+                }
+            };
+
+#if not (defined(__unix__) or defined(__APPLE__))
+            std::string mBuffer;
+#endif
+            std::string_view mContent;
+            std::vector<slot> mSlots;
+            std::deque<named_value> mValues;
+            std::size_t mSize{0};
+
+            static std::string_view trim(std::string_view text) {
+                while (not text.empty() and std::isspace(static_cast<unsigned char>(text.front()))) {
+                    text.remove_prefix(1);
+                }
+
+                while (not text.empty() and std::isspace(static_cast<unsigned char>(text.back()))) {
+                    text.remove_suffix(1);
+                }
+
+                return text;
+            }
+
+            /*
+             * fnv-1a of "section.key" (or "key"), without composing it.
+             */
+            static std::size_t hash(std::string_view section, std::string_view key) {
+                uint64_t result = 14695981039346656037ull;
+
+                auto add = [&](std::string_view text) {
+                    for (auto c: text) {
+                        result = (result ^ static_cast<unsigned char>(c))*1099511628211ull;
+                    }
+                };
+
+                if (not section.empty()) {
+                    add(section);
+                    add(".");
+                }
+
+                add(key);
+
+                return static_cast<std::size_t>(result);
+            }
+
+            void insert(std::string_view section, std::string_view key, std::string_view text) {
+                auto mask = mSlots.size() - 1;
+                auto i = hash(section, key) & mask;
+
+                for (; mSlots[i].key.data() != nullptr; i = (i + 1) & mask) {
+                    auto &slot = mSlots[i];
+
+                    if (slot.section == section and slot.key == key) {
+                        slot.text = text;
+
+                        return;
+                    }
+                }
+
+                mSlots[i] = {section, key, text};
+                mSize++;
+            }
+
+            /*
+             * the mapping (or, where mmap is not available, the buffer) is
+             * released with the named_file, which the views handed out must
+             * not outlive.
+             */
+            std::string_view map(std::string const &path) {
+#if defined(__unix__) or defined(__APPLE__)
+                int fd = ::open(path.c_str(), O_RDONLY);
+
+                if (fd < 0) {
+                    throw std::runtime_error("jinject::unable to open \"" + path + "\"");
+                }
+
+                struct stat info;
+
+                if (::fstat(fd, &info) != 0) {
+                    ::close(fd);
+
+                    throw std::runtime_error("jinject::unable to open \"" + path + "\"");
+                }
+
+                if (info.st_size == 0) {
+                    ::close(fd);
+
+                    return {};
+                }
+
+                auto address = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+                ::close(fd);
+
+                if (address == MAP_FAILED) {
+                    throw std::runtime_error("jinject::unable to map \"" + path + "\"");
+                }
+
+                return {static_cast<char const *>(address), static_cast<std::size_t>(info.st_size)};
+#else
+                std::ifstream file{path, std::ios::binary};
+
+                if (!file) {
+                    throw std::runtime_error("jinject::unable to open \"" + path + "\"");
+                }
+
+                mBuffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+
+                return mBuffer;
+#endif
+            }
+        };
+    }
+
+    struct named {
+        named(std::string const &id, auto const &value) {
+            add(id, value);
+        }
+
+        named(std::string const &id, char const *value) {
+            add(id, std::string_view{value});
+        }
+
+        /*
+         * result of a lookup, valid while no name or file is added after it
+         * (the generation it was made in) or for good when a NAMED value was
+         * found, as those take precedence over everything added later.
+         */
+        struct lookup {
+            details::named_value const *value;
+            std::size_t generation;
+            bool final;
+        };
+
+        static details::named_value const * find(std::string_view id) {
+            return resolve(id)->value;
+        }
+
+        static lookup const * resolve(std::string_view id) {
+            std::lock_guard lock{sMutex};
+
+            auto generation = sGeneration.load(std::memory_order_relaxed);
+            auto item = sNames.find(id);
+
+            if (item != sNames.end()) {
+                return &sLookups.emplace_back(&item->second, generation, true);
+            }
+
+            for (auto file = sFiles.rbegin(); file != sFiles.rend(); file++) {
+                if (auto value = (*file)->find(id)) {
+                    return &sLookups.emplace_back(value, generation, false);
+                }
+            }
+
+            return &sLookups.emplace_back(nullptr, generation, false);
+        }
+
+        static bool current(lookup const &result) {
+            return result.final or result.generation == sGeneration.load(std::memory_order_acquire);
+        }
+
+        /*
+         * maps a key=value file whose keys are then resolved by get_named, and
+         * returns the number of keys; NAMED values take precedence over the
+         * files and later files over earlier ones.
+         */
+        static std::size_t load(std::string const &path) {
+            auto file = std::make_unique<details::named_file>(path);
+            auto size = file->size();
+
+            std::lock_guard lock{sMutex};
+
+            sFiles.push_back(std::move(file));
+            sGeneration.fetch_add(1, std::memory_order_release);
+
+            return size;
+        }
+
+        inline static std::map<std::string, details::named_value, std::less<> > sNames;
+
+    private:
+        inline static std::mutex sMutex;
+        inline static std::vector<std::unique_ptr<details::named_file> > sFiles;
+        inline static std::deque<lookup> sLookups;
+        inline static std::atomic<std::size_t> sGeneration{0};
+
+        template<typename Value>
+        static void add(std::string const &id, Value const &value) {
+            std::lock_guard lock{sMutex};
+
+            if (sNames.find(id) != sNames.end()) {
+                throw std::runtime_error(std::string("Name") + " '" + id + "' already defined");
+            }
+
+            sNames.try_emplace(id, value);
+            sGeneration.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    inline std::size_t load_named(std::string const &path) {
+        return named::load(path);
+    }
+
+    template<jmixin::StringLiteral ID>
+    struct get_named {
+        get_named(std::string const &value = "")
+            : mDefault{value} {
+        }
+
+        std::expected<int32_t, std::string> get_int() {
+            if (auto value = typed_value<int32_t>()) {
+                return *value;
+            }
+
+            return std::unexpected{"unable to convert named value to 'int'"};
+        }
+
+        std::expected<int64_t, std::string> get_long() {
+            if (auto value = typed_value<int64_t>()) {
+                return *value;
+            }
+
+            return std::unexpected{"unable to convert named value to 'long'"};
+        }
+
+        std::expected<float, std::string> get_float() {
+            if (auto value = typed_value<float>()) {
+                return *value;
+            }
+
+            return std::unexpected{"unable to convert named value to 'float'"};
+        }
+
+        std::expected<double, std::string> get_double() {
+            if (auto value = typed_value<double>()) {
+                return *value;
+            }
+
+            return std::unexpected{"unable to convert named value to 'double'"};
+        }
+
+        std::expected<jmixin::String, std::string> get_string() {
+            if (auto value = resolve()) {
+                jmixin::String result = std::string{value->text()};
+
+                return {result};
+            }
+
+            return std::unexpected{"no return registered"};
+        }
+
+        std::string_view get_view() const {
+            if (auto value = resolve()) {
+                return value->text();
+            }
+
+            return mDefault;
+        }
+
+        template<typename... Args>
+        jmixin::String format(Args... args) {
+            return get_string().value_or(mDefault).format(args...);
+        }
+
+        operator std::string() {
+            return std::string{get_view()};
+        }
+
+        operator jmixin::String() {
+            return get_string().value_or(mDefault);
+        }
+
+    private:
+        jmixin::String mDefault;
+
+        template<typename T>
+        static T const * typed_value() {
+            if (auto value = resolve()) {
+                return value->template as<T>();
+            }
+
+            return nullptr;
+        }
+
+        /*
+         * named values are never removed, so the last lookup of the name is
+         * cached and reused, with a single load, until a name or a file that
+         * could shadow it is added.
+         */
+        static details::named_value const * resolve() {
+            if (auto result = sLookup.load(std::memory_order_acquire); result and named::current(*result)) {
+                return result->value;
+            }
+
+            static std::string const id = ID.to_string();
+
+            auto result = named::resolve(id);
+
+            sLookup.store(result, std::memory_order_release);
+
+            return result->value;
+        }
+
+        static inline std::atomic<named::lookup const *> sLookup;
+    };
+
+    enum locale_index : int {
+        CURRENT_LOCALE = -2,
+        ORIGINAL_LOCALE = -1
+    };
+
+    namespace details {
+        inline std::atomic<int> sLocale{ORIGINAL_LOCALE};
+
+        inline thread_local int sThreadLocale{CURRENT_LOCALE};
+    }
+
+    /*
+     * process wide locale used by _T() when no index is given.
+     */
+    inline void set_locale(int id) {
+        details::sLocale.store(id, std::memory_order_relaxed);
+    }
+
+    /*
+     * overrides the process wide locale in the calling thread; CURRENT_LOCALE
+     * restores the process wide one.
+     */
+    inline void set_thread_locale(int id) {
+        details::sThreadLocale = id;
+    }
+
+    inline int get_locale() {
+        if (details::sThreadLocale != CURRENT_LOCALE) {
+            return details::sThreadLocale;
+        }
+
+        return details::sLocale.load(std::memory_order_relaxed);
+    }
+
+    template<jmixin::StringLiteral TEXT>
+    struct typed {
+        typed() {
+            if (sDefined.exchange(true)) {
+                throw std::runtime_error(std::string("Name") + " '" + TEXT.to_string() + "' already defined");
+            }
+        }
+
+        typed & add(std::size_t id, std::string_view value) {
+            if (id >= JINJECT_MAX_LOCALES) {
+                throw std::runtime_error("jinject::locale index out of range");
+            }
+
+            std::lock_guard lock{sMutex};
+
+            sNames[id].store(&sStorage.emplace_back(std::string{value}), std::memory_order_release);
+
+            return *this;
+        }
+
+        static std::string_view find(int id) {
+            if (id >= 0 and id < JINJECT_MAX_LOCALES) {
+                if (auto value = sNames[id].load(std::memory_order_acquire)) {
+                    return *value;
+                }
+            }
+
+            return text();
+        }
+
+        static std::string_view text() {
+            static std::string const value = TEXT.to_string();
+
+            return value;
+        }
+
+        inline static std::array<std::atomic<jmixin::String const *>, JINJECT_MAX_LOCALES> sNames;
+
+    private:
+        inline static std::atomic<bool> sDefined;
+        inline static std::deque<jmixin::String> sStorage;
+        inline static std::mutex sMutex;
+    };
+
+    template<jmixin::StringLiteral TEXT, int INDEX = CURRENT_LOCALE>
+    struct get_typed {
+        get_typed() = default;
+
+        std::string_view view() const {
+            if constexpr (INDEX == CURRENT_LOCALE) {
+                return typed<TEXT>::find(get_locale());
+            } else {
+                return typed<TEXT>::find(INDEX);
+            }
+        }
+
+        operator std::string_view() const {
+            return view();
+        }
+
+        operator std::string() const {
+            return std::string{view()};
+        }
+    };
+
+    /*
+     * request/session scope of SCOPED bindings: while a scope is alive it is
+     * the current scope of its thread, and each SCOPED binding resolved in it
+     * is constructed once, in an arena owned by the scope. The instances are
+     * destroyed in reverse order of construction and their memory released
+     * in bulk when the scope ends. Nested scopes see the instances of the
+     * enclosing ones. Each SCOPED binding owns a slot of the instance table
+     * of every scope, so a lookup is one index per enclosing scope.
+     *
+     * A scope belongs to the thread that created it and must be destroyed in
+     * the reverse order of creation.
+     */
+    class scope {
+    public:
+        explicit scope(std::size_t initialSize = 4096)
+            : mResource{initialSize}, mParent{sCurrent} {
+            sCurrent = this;
+        }
+
+        scope(scope const &) = delete;
+
+        scope(scope &&) = delete;
+
+        ~scope() {
+            for (auto item = mInstances.rbegin(); item != mInstances.rend(); item++) {
+                item->destroy(item->instance);
+            }
+
+            sCurrent = mParent;
+        }
+
+        static scope * current() {
+            return sCurrent;
+        }
+
+        /*
+         * index of a SCOPED binding in the instance table of every scope.
+         */
+        static std::size_t allocate_slot() {
+            return sSlots.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        template<typename T, typename Callback>
+        T * instance(std::size_t slot, Callback const &callback) {
+            for (auto owner = this; owner != nullptr; owner = owner->mParent) {
+                if (slot < owner->mSlots.size() and owner->mSlots[slot] != nullptr) {
+                    return static_cast<T *>(owner->mSlots[slot]);
+                }
+            }
+
+            auto storage = mResource.allocate(sizeof(T), alignof(T));
+            auto instance = ::new(storage) T(callback());
+
+            if (slot >= mSlots.size()) {
+                mSlots.resize(std::max(slot + 1, sSlots.load(std::memory_order_relaxed)), nullptr);
+            }
+
+            mSlots[slot] = instance;
+
+            mInstances.push_back(entry{
+                instance, [](void *instance) {
+                    static_cast<T *>(instance)->~T();
+                }
+            });
+
+            return instance;
+        }
+
+    private:
+        struct entry {
+            void *instance;
+            void (*destroy)(void *);
+        };
+
+        std::pmr::monotonic_buffer_resource mResource;
+        std::pmr::vector<void *> mSlots{std::pmr::polymorphic_allocator<void *>{&mResource}};
+        std::pmr::vector<entry> mInstances{&mResource};
+        scope *mParent;
+
+        inline static std::atomic<std::size_t> sSlots{0};
+        inline static thread_local scope *sCurrent = nullptr;
+    };
+
+    /*
+     * high_water is the largest number of entries a thread has kept cached.
+     */
+    struct pool_statistics {
+        std::size_t allocations;
+        std::size_t reuses;
+        std::size_t releases;
+        std::size_t cached;
+        std::size_t high_water;
+    };
+
+    namespace details {
+        /*
+         * relaxed counter owned by a single writer thread: increments are a
+         * plain load and store, while other threads may read it at any time.
+         */
+        struct local_counter {
+            std::atomic<std::size_t> mValue{0};
+
+            void add(std::size_t value = 1) {
+                mValue.store(mValue.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+            }
+
+            void raise(std::size_t value) {
+                if (value > get()) {
+                    mValue.store(value, std::memory_order_relaxed);
+                }
+            }
+
+            std::size_t get() const {
+                return mValue.load(std::memory_order_relaxed);
+            }
+        };
+
+        /*
+         * per-thread state of a component: local() returns the Local of the
+         * calling thread (nullptr once the thread has destroyed it) and
+         * snapshot() sums the live ones, through their collect(Totals &), with
+         * the totals the finished threads have left behind (their retire(),
+         * when Local has one, or else their collect()).
+         */
+        template<typename Local, typename Totals>
+        struct thread_registry {
+            static Local * local() {
+                if (not sAlive) {
+                    return nullptr;
+                }
+
+                thread_local entry current;
+
+                return &current;
+            }
+
+            static Totals snapshot() {
+                std::lock_guard lock{sMutex};
+
+                auto result = sRetired;
+
+                for (auto entry: sEntries) {
+                    entry->collect(result);
+                }
+
+                return result;
+            }
+
+        private:
+            struct entry : Local {
+                entry() {
+                    std::lock_guard lock{sMutex};
+
+                    sEntries.push_back(this);
+                }
+
+                ~entry() {
+                    sAlive = false;
+
+                    std::lock_guard lock{sMutex};
+
+                    if constexpr (requires { this->retire(sRetired); }) {
+                        this->retire(sRetired);
+                    } else {
+                        this->collect(sRetired);
+                    }
+
+                    std::erase(sEntries, static_cast<Local *>(this));
+                }
+            };
+
+            inline static thread_local bool sAlive = true;
+            inline static std::mutex sMutex;
+            inline static std::vector<Local *> sEntries;
+            inline static Totals sRetired{};
+        };
+
+        /*
+         * bounded stack of released items kept by a thread for its next
+         * requests, with the pool_statistics counters of that thread.
+         */
+        template<typename Item, std::size_t Capacity>
+        struct pool_cache {
+            Item mItems[Capacity];
+            std::atomic<std::size_t> mCount{0};
+            local_counter mAllocations;
+            local_counter mReuses;
+            local_counter mReleases;
+            local_counter mHighWater;
+
+            Item pop() {
+                auto count = mCount.load(std::memory_order_relaxed);
+
+                if (count > 0) {
+                    mReuses.add();
+                    mCount.store(count - 1, std::memory_order_relaxed);
+
+                    return mItems[count - 1];
+                }
+
+                mAllocations.add();
+
+                return nullptr;
+            }
+
+            bool push(Item item) {
+                auto count = mCount.load(std::memory_order_relaxed);
+
+                mReleases.add();
+
+                if (count < Capacity) {
+                    mItems[count] = item;
+                    mCount.store(count + 1, std::memory_order_relaxed);
+                    mHighWater.raise(count + 1);
+
+                    return true;
+                }
+
+                return false;
+            }
+
+            void collect(pool_statistics &result) const {
+                retire(result);
+
+                result.cached += mCount.load(std::memory_order_relaxed);
+            }
+
+            void retire(pool_statistics &result) const {
+                result.allocations += mAllocations.get();
+                result.reuses += mReuses.get();
+                result.releases += mReleases.get();
+                result.high_water = std::max(result.high_water, mHighWater.get());
+            }
+        };
+
+        /*
+         * recycles the storage of T: released blocks are kept in a bounded
+         * cache of the releasing thread and handed out again by the next
+         * allocations of that thread, falling back to operator new/delete.
+         * Statistics are kept per thread and summed on request.
+         */
+        template<typename T>
+        struct memory_pool {
+            static constexpr std::size_t capacity = 64;
+
+            static void * allocate() {
+                if (auto blocks = registry::local()) {
+                    if (auto block = blocks->pop()) {
+                        return block;
+                    }
+                }
+
+                return ::operator new(sizeof(T), std::align_val_t{alignof(T)});
+            }
+
+            static void release(void *block) {
+                if (auto blocks = registry::local(); blocks and blocks->push(block)) {
+                    return;
+                }
+
+                ::operator delete(block, std::align_val_t{alignof(T)});
+            }
+
+            static pool_statistics statistics() {
+                return registry::snapshot();
+            }
+
+        private:
+            struct cache : pool_cache<void *, capacity> {
+                ~cache() {
+                    for (std::size_t i = 0; i < this->mCount.load(std::memory_order_relaxed); i++) {
+                        ::operator delete(this->mItems[i], std::align_val_t{alignof(T)});
+                    }
+                }
+            };
+
+            using registry = thread_registry<cache, pool_statistics>;
+        };
+    }
+
+    /*
+     * memory policy of POOL_UNIQUE bindings; specialize it to plug another
+     * pool with the static allocate()/release(void *)/statistics() interface.
+     */
+    template<typename T>
+    struct allocation_policy {
+        using type = details::memory_pool<T>;
+    };
+
+    namespace details {
+        template<typename T>
+        struct pool_deleter {
+            void operator()(T *ptr) const {
+                ptr->~T();
+
+                allocation_policy<T>::type::release(ptr);
+            }
+        };
+    }
+
+    template<typename T>
+    using pool_ptr = std::unique_ptr<T, details::pool_deleter<T> >;
+
+    template<typename T>
+    pool_statistics pool_stats() {
+        return allocation_policy<T>::type::statistics();
+    }
+
+    /*
+     * brings a released POOLED instance back to a reusable state; the default
+     * calls its reset() member, if there is one. An instance whose reset
+     * throws is destroyed instead of being reused.
+     */
+    template<typename T>
+    struct reset_policy {
+        static void reset(T &value) {
+            if constexpr (requires { value.reset(); }) {
+                value.reset();
+            }
+        }
+    };
+
+    namespace details {
+        /*
+         * recycles whole instances of T: released instances are reset and
+         * kept in a bounded cache of the releasing thread, and handed out
+         * again by the next acquisitions of that thread instead of being
+         * constructed. Statistics are kept per thread like the memory_pool
+         * ones, allocations counting the constructed instances.
+         */
+        template<typename T>
+        struct object_pool {
+            static constexpr std::size_t capacity = 64;
+
+            template<typename Create>
+            static T * acquire(Create &&create) {
+                if (auto objects = registry::local()) {
+                    if (auto object = objects->pop()) {
+                        return object;
+                    }
+                }
+
+                return create();
+            }
+
+            static void release(T *object) noexcept {
+                try {
+                    reset_policy<T>::reset(*object);
+                } catch (...) {
+                    delete object;
+
+                    return;
+                }
+
+                if (auto objects = registry::local(); objects and objects->push(object)) {
+                    return;
+                }
+
+                delete object;
+            }
+
+            static pool_statistics statistics() {
+                return registry::snapshot();
+            }
+
+        private:
+            struct cache : pool_cache<T *, capacity> {
+                ~cache() {
+                    for (std::size_t i = 0; i < this->mCount.load(std::memory_order_relaxed); i++) {
+                        delete this->mItems[i];
+                    }
+                }
+            };
+
+            using registry = thread_registry<cache, pool_statistics>;
+        };
+
+        template<typename T>
+        struct pooled_deleter {
+            void operator()(T *ptr) const {
+                object_pool<T>::release(ptr);
+            }
+        };
+    }
+
+    template<typename T>
+    using pooled_ptr = std::unique_ptr<T, details::pooled_deleter<T> >;
+
+    template<typename T>
+    pool_statistics pooled_stats() {
+        return details::object_pool<T>::statistics();
+    }
+
+    struct warmup_report {
+        struct node {
+            std::string name;
+            std::chrono::nanoseconds self;
+            std::vector<std::size_t> dependencies;
+        };
+
+        std::vector<node> nodes;
+        std::vector<std::size_t> critical_path;
+        std::chrono::nanoseconds critical_time{};
+        std::chrono::nanoseconds elapsed{};
+
+        std::string to_string() const {
+            std::ostringstream o;
+
+            o << "jinject::warmup " << nodes.size() << " singles in " << elapsed.count() << "ns, critical path "
+                << critical_time.count() << "ns\n";
+
+            for (auto index: critical_path) {
+                o << "  " << nodes[index].name << " " << nodes[index].self.count() << "ns\n";
+            }
+
+            return o.str();
+        }
+    };
+
+    namespace details {
+        struct deferred_node {
+            void const *key;
+            std::string (*name)();
+            void (*construct)();
+        };
+
+        /*
+         * dependency graph of the deferred singles constructed while a warm-up
+         * runs: a node per single with the time spent in its own callback, and
+         * an edge for each single resolved from inside another one.
+         */
+        struct warmup_trace {
+            struct node {
+                void const *key;
+                std::string (*name)();
+                std::chrono::nanoseconds self;
+                std::vector<std::size_t> dependencies;
+            };
+
+            void depend(deferred_node const &parent, deferred_node const &child) {
+                std::lock_guard lock{mMutex};
+
+                auto from = index(parent);
+                auto to = index(child);
+                auto &dependencies = mNodes[from].dependencies;
+
+                if (std::find(dependencies.begin(), dependencies.end(), to) == dependencies.end()) {
+                    dependencies.push_back(to);
+                }
+            }
+
+            void complete(deferred_node const &node, std::chrono::nanoseconds self) {
+                std::lock_guard lock{mMutex};
+
+                mNodes[index(node)].self = self;
+            }
+
+            warmup_report report(std::chrono::nanoseconds elapsed) {
+                std::lock_guard lock{mMutex};
+
+                warmup_report result;
+
+                result.elapsed = elapsed;
+
+                for (auto const &node: mNodes) {
+                    result.nodes.push_back({node.name(), node.self, node.dependencies});
+                }
+
+                std::vector<std::chrono::nanoseconds> costs(mNodes.size(), std::chrono::nanoseconds{-1});
+                std::vector<std::size_t> next(mNodes.size(), mNodes.size());
+
+                auto cost = [&](auto &self, std::size_t i) -> std::chrono::nanoseconds {
+                    if (costs[i].count() < 0) {
+                        costs[i] = std::chrono::nanoseconds{0};
+
+                        std::chrono::nanoseconds longest{0};
+
+                        for (auto dependency: mNodes[i].dependencies) {
+                            if (auto value = self(self, dependency); value > longest or next[i] == mNodes.size()) {
+                                longest = value;
+                                next[i] = dependency;
+                            }
+                        }
+
+                        costs[i] = mNodes[i].self + longest;
+                    }
+
+                    return costs[i];
+                };
+
+                for (std::size_t i = 0; i < mNodes.size(); i++) {
+                    if (cost(cost, i) > result.critical_time or result.critical_path.empty()) {
+                        result.critical_time = costs[i];
+                        result.critical_path = {i};
+                    }
+                }
+
+                while (not result.critical_path.empty() and next[result.critical_path.back()] != mNodes.size()) {
+                    result.critical_path.push_back(next[result.critical_path.back()]);
+                }
+
+                return result;
+            }
+
+        private:
+            std::mutex mMutex;
+            std::vector<node> mNodes;
+
+            std::size_t index(deferred_node const &node) {
+                for (std::size_t i = 0; i < mNodes.size(); i++) {
+                    if (mNodes[i].key == node.key) {
+                        return i;
+                    }
+                }
+
+                mNodes.push_back({node.key, node.name, {}, {}});
+
+                return mNodes.size() - 1;
+            }
+        };
+
+        inline std::atomic<warmup_trace *> sWarmupTrace{nullptr};
+
+        struct construction_frame {
+            deferred_node const *node;
+            std::chrono::nanoseconds children;
+        };
+
+        inline thread_local std::vector<construction_frame> sConstructions;
+
+        /*
+         * wraps a request of a deferred single: detects cycles in the calling
+         * thread and, during a warm-up, records the dependency on it of the single being built by
+         * the calling thread (the request time, waits included, is not part of
+         * the parent's own time).
+         */
+        struct construction_request {
+            explicit construction_request(deferred_node const &node)
+                : mNode{node}, mStart{std::chrono::steady_clock::now()} {
+                for (auto const &frame: sConstructions) {
+                    if (frame.node->key == node.key) {
+                        throw std::runtime_error("jinject::cyclic dependency on \"" + node.name() + "\"");
+                    }
+                }
+            }
+
+            ~construction_request() {
+                if (sConstructions.empty()) {
+                    return;
+                }
+
+                auto &parent = sConstructions.back();
+
+                parent.children += std::chrono::steady_clock::now() - mStart;
+
+                if (auto trace = sWarmupTrace.load(std::memory_order_acquire)) {
+                    trace->depend(*parent.node, mNode);
+                }
+            }
+
+        private:
+            deferred_node const &mNode;
+            std::chrono::steady_clock::time_point mStart;
+        };
+
+        /*
+         * wraps the callback of a deferred single while it runs.
+         */
+        struct construction_build {
+            explicit construction_build(deferred_node const &node)
+                : mStart{std::chrono::steady_clock::now()} {
+                sConstructions.push_back({&node, {}});
+            }
+
+            ~construction_build() {
+                auto frame = sConstructions.back();
+
+                sConstructions.pop_back();
+
+                if (auto trace = sWarmupTrace.load(std::memory_order_acquire)) {
+                    trace->complete(*frame.node, std::chrono::steady_clock::now() - mStart - frame.children);
+                }
+            }
+
+        private:
+            std::chrono::steady_clock::time_point mStart;
+        };
+
+        /*
+         * lock of a deferred single while a thread constructs it. The singles
+         * being built and the ones each thread waits for form a waits-for
+         * graph: a thread that would close a cycle across threads throws
+         * instead of blocking forever.
+         */
+        struct construction_lock {
+            construction_lock(deferred_node const &node, std::mutex &mutex)
+                : mNode{node}, mMutex{mutex} {
+                {
+                    std::lock_guard lock{sMutex};
+
+                    auto self = std::this_thread::get_id();
+
+                    for (auto key = node.key;;) {
+                        auto owner = sOwners.find(key);
+
+                        if (owner == sOwners.end()) {
+                            break;
+                        }
+
+                        if (owner->second == self) {
+                            throw std::runtime_error("jinject::cyclic dependency on \"" + node.name() + "\"");
+                        }
+
+                        auto wait = sWaits.find(owner->second);
+
+                        if (wait == sWaits.end()) {
+                            break;
+                        }
+
+                        key = wait->second;
+                    }
+
+                    sWaits[self] = node.key;
+                }
+
+                mMutex.lock();
+
+                std::lock_guard lock{sMutex};
+
+                sWaits.erase(std::this_thread::get_id());
+                sOwners[node.key] = std::this_thread::get_id();
+            }
+
+            construction_lock(construction_lock const &) = delete;
+
+            ~construction_lock() {
+                {
+                    std::lock_guard lock{sMutex};
+
+                    sOwners.erase(mNode.key);
+                }
+
+                mMutex.unlock();
+            }
+
+        private:
+            deferred_node const &mNode;
+            std::mutex &mMutex;
+
+            inline static std::mutex sMutex;
+            inline static std::unordered_map<void const *, std::thread::id> sOwners;
+            inline static std::unordered_map<std::thread::id, void const *> sWaits;
+        };
+    }
+
+    /*
+     * startup phase of SINGLE bindings: while a warmup is alive, the SINGLE
+     * bindings declared by its thread are deferred instead of constructed,
+     * and run() constructs them concurrently. A single resolving another
+     * deferred single constructs it first (or waits for the thread building
+     * it), so dependencies are respected without being declared, and the
+     * resulting graph is returned with its critical path.
+     *
+     * warmup startup;
+     *
+     * LoadModules();
+     *
+     * std::cout << startup.run().to_string();
+     */
+    class warmup {
+    public:
+        warmup()
+            : mParent{sCurrent} {
+            sCurrent = this;
+        }
+
+        warmup(warmup const &) = delete;
+
+        warmup(warmup &&) = delete;
+
+        ~warmup() {
+            stop();
+        }
+
+        static warmup * current() {
+            return sCurrent;
+        }
+
+        void add(details::deferred_node node) {
+            mNodes.push_back(node);
+        }
+
+        warmup_report run(std::size_t workers = std::thread::hardware_concurrency()) {
+            stop();
+
+            details::warmup_trace trace;
+            details::warmup_trace *expected = nullptr;
+
+            if (not details::sWarmupTrace.compare_exchange_strong(expected, &trace)) {
+                throw std::runtime_error("jinject::warmup already running");
+            }
+
+            auto start = std::chrono::steady_clock::now();
+
+            try {
+                details::parallel_for(mNodes.size(),
+                                      [this](std::size_t i) {
+                                          mNodes[i].construct();
+                                      }, workers);
+            } catch (...) {
+                details::sWarmupTrace.store(nullptr, std::memory_order_release);
+
+                throw;
+            }
+
+            details::sWarmupTrace.store(nullptr, std::memory_order_release);
+
+            return trace.report(std::chrono::steady_clock::now() - start);
+        }
+
+    private:
+        std::vector<details::deferred_node> mNodes;
+        warmup *mParent;
+        bool mActive{true};
+
+        inline static thread_local warmup *sCurrent = nullptr;
+
+        void stop() {
+            if (mActive) {
+                sCurrent = mParent;
+                mActive = false;
+            }
+        }
+    };
+
+    template<typename... Signature>
+    struct get;
+
+    template<typename T>
+    struct introspection;
+
+    /*
+     * resolution metrics of a binding, summed over all threads; the latency
+     * bucket i counts the constructions that took less than 2^i nanoseconds
+     * (and at least 2^(i-1)), the last bucket also counts the slower ones.
+     */
+    struct binding_metrics {
+        std::string type;
+        std::string signature;
+        std::size_t resolutions;
+        std::size_t constructions;
+        std::chrono::nanoseconds elapsed;
+        std::array<std::size_t, 32> latency;
+
+        std::string to_string() const {
+            std::ostringstream out;
+
+            out << type;
+
+            if (!signature.empty()) {
+                out << " [" << signature << "]";
+            }
+
+            out << ": " << resolutions << " resolutions, " << constructions << " constructions";
+
+            if (constructions > 0) {
+                out << ", " << elapsed.count()/constructions << "ns average";
+            }
+
+            return out.str();
+        }
+    };
+
+    inline constexpr bool metrics_enabled = JINJECT_METRICS != 0;
+
+    namespace details {
+        struct metrics_registry {
+            static void add(binding_metrics (*snapshot)()) {
+                std::lock_guard lock{sMutex};
+
+                sBindings.push_back(snapshot);
+            }
+
+            static std::vector<binding_metrics> snapshot() {
+                std::vector<binding_metrics (*)()> bindings;
+
+                {
+                    std::lock_guard lock{sMutex};
+
+                    bindings = sBindings;
+                }
+
+                std::vector<binding_metrics> result;
+
+                for (auto snapshot: bindings) {
+                    result.push_back(snapshot());
+                }
+
+                return result;
+            }
+
+        private:
+            inline static std::mutex sMutex;
+            inline static std::vector<binding_metrics (*)()> sBindings;
+        };
+
+        /*
+         * counters of a binding kept per thread, like the memory_pool ones:
+         * the owner thread updates them with relaxed loads and stores and a
+         * snapshot sums the live threads with the totals of the finished ones.
+         */
+        template<typename T, typename... Signature>
+        struct binding_counters {
+            static void resolution() {
+                if (auto current = registry::local()) {
+                    current->mResolutions.add();
+                }
+            }
+
+            static void construction(std::chrono::nanoseconds elapsed) {
+                if (auto current = registry::local()) {
+                    auto ns = static_cast<std::size_t>(std::max<std::chrono::nanoseconds::rep>(elapsed.count(), 0));
+
+                    current->mConstructions.add();
+                    current->mElapsed.add(ns);
+                    current->mLatency[std::min<std::size_t>(std::bit_width(ns), current->mLatency.size() - 1)].add();
+                }
+            }
+
+            static binding_metrics snapshot() {
+                auto result = registry::snapshot();
+
+                result.type = introspection<T>::to_string();
+                ((result.signature += (result.signature.empty() ? "" : ", ") + introspection<Signature>::to_string()), ...);
+
+                return result;
+            }
+
+        private:
+            struct counters {
+                local_counter mResolutions;
+                local_counter mConstructions;
+                local_counter mElapsed;
+                std::array<local_counter, std::tuple_size_v<decltype(binding_metrics::latency)> > mLatency;
+
+                counters() {
+                    [[maybe_unused]] static bool const registered = (metrics_registry::add(&snapshot), true);
+                }
+
+                void collect(binding_metrics &result) const {
+                    result.resolutions += mResolutions.get();
+                    result.constructions += mConstructions.get();
+                    result.elapsed += std::chrono::nanoseconds(mElapsed.get());
+
+                    for (std::size_t i = 0; i < mLatency.size(); i++) {
+                        result.latency[i] += mLatency[i].get();
+                    }
+                }
+            };
+
+            using registry = thread_registry<counters, binding_metrics>;
+        };
+
+        /*
+         * times the construction of an instance of a binding while in scope.
+         */
+        template<typename T, typename... Signature>
+        struct probe_construction {
+            explicit probe_construction(bool enabled = true) {
+                if constexpr (metrics_enabled) {
+                    if (enabled) {
+                        mStart = std::chrono::steady_clock::now();
+                    }
+                }
+            }
+
+            ~probe_construction() {
+                if constexpr (metrics_enabled) {
+                    if (mStart != std::chrono::steady_clock::time_point{}) {
+                        binding_counters<T, Signature...>::construction(std::chrono::steady_clock::now() - mStart);
+                    }
+                }
+            }
+
+        private:
+            std::chrono::steady_clock::time_point mStart{};
+        };
+    }
+
+    /*
+     * metrics of every binding resolved so far; empty unless JINJECT_METRICS
+     * is set.
+     */
+    inline std::vector<binding_metrics> metrics() {
+        return details::metrics_registry::snapshot();
+    }
+
+    template<typename T, typename... Signature>
+    binding_metrics metrics_of() {
+        if constexpr (metrics_enabled) {
+            return details::binding_counters<T, Signature...>::snapshot();
+        } else {
+            return {};
+        }
+    }
+
+    /*
+     * resolutions recorded by a trace: parent is the index of the resolution
+     * that requested this one from inside its callback (or npos for a root),
+     * thread the order of first appearance of the resolving thread and start
+     * is relative to the beginning of the trace.
+     */
+    struct trace_report {
+        static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+        struct event {
+            std::string name;
+            std::size_t parent;
+            std::size_t thread;
+            std::chrono::nanoseconds start;
+            std::chrono::nanoseconds duration;
+        };
+
+        std::vector<event> events;
+
+        /*
+         * chrome trace-event format, for chrome://tracing or perfetto.
+         */
+        std::string to_chrome() const {
+            std::ostringstream out;
+
+            out << "{\"traceEvents\":[";
+
+            for (std::size_t i = 0; i < events.size(); i++) {
+                auto const &event = events[i];
+
+                out << (i == 0 ? "" : ",") << "\n{\"name\":\"";
+
+                for (auto c: event.name) {
+                    if (c == '"' or c == '\\') {
+                        out << '\\';
+                    }
+
+                    out << c;
+                }
+
+                out << "\",\"cat\":\"jinject\",\"ph\":\"X\",\"pid\":0,\"tid\":" << event.thread
+                    << std::fixed << std::setprecision(3)
+                    << ",\"ts\":" << event.start.count()/1000.0
+                    << ",\"dur\":" << event.duration.count()/1000.0
+                    << ",\"args\":{\"id\":" << i;
+
+                if (event.parent != npos) {
+                    out << ",\"parent\":" << event.parent;
+                }
+
+                out << "}}";
+            }
+
+            out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+            return out.str();
+        }
+
+        /*
+         * folded stacks with the self time of each resolution in nanoseconds,
+         * for flamegraph.pl or speedscope.
+         */
+        std::string to_folded() const {
+            std::vector<std::chrono::nanoseconds> self(events.size());
+            std::map<std::string, std::chrono::nanoseconds::rep> stacks;
+
+            for (std::size_t i = 0; i < events.size(); i++) {
+                self[i] += events[i].duration;
+
+                if (events[i].parent != npos) {
+                    self[events[i].parent] -= events[i].duration;
+                }
+            }
+
+            for (std::size_t i = 0; i < events.size(); i++) {
+                std::string stack = events[i].name;
+
+                for (auto parent = events[i].parent; parent != npos; parent = events[parent].parent) {
+                    stack = events[parent].name + ";" + stack;
+                }
+
+                stacks[stack] += std::max<std::chrono::nanoseconds::rep>(self[i].count(), 0);
+            }
+
+            std::ostringstream out;
+
+            for (auto const &[stack, value]: stacks) {
+                out << stack << " " << value << "\n";
+            }
+
+            return out.str();
+        }
+    };
+
+    inline constexpr bool trace_enabled = JINJECT_TRACE != 0;
+
+    namespace details {
+        template<typename T, typename... Signature>
+        std::string binding_name() {
+            std::string result = introspection<T>::to_string();
+
+            if constexpr (sizeof...(Signature) > 0) {
+                std::string signature;
+
+                ((signature += (signature.empty() ? "" : ", ") + introspection<Signature>::to_string()), ...);
+
+                result += " [" + signature + "]";
+            }
+
+            return result;
+        }
+
+        struct trace_buffer {
+            struct record {
+                std::size_t id;
+                std::size_t parent;
+                std::string (*name)();
+                std::thread::id thread;
+                std::chrono::steady_clock::time_point start;
+                std::chrono::steady_clock::time_point end;
+            };
+
+            std::chrono::steady_clock::time_point mStart{std::chrono::steady_clock::now()};
+            std::atomic<std::size_t> mNext{0};
+            std::mutex mMutex;
+            std::vector<record> mRecords;
+        };
+
+        inline std::atomic<bool> sTracing{false};
+        inline std::mutex sTraceMutex;
+        inline std::shared_ptr<trace_buffer> sTraceBuffer;
+
+        struct trace_frame {
+            trace_buffer *buffer;
+            std::size_t id;
+        };
+
+        inline thread_local std::vector<trace_frame> sTraceFrames;
+
+        /*
+         * probe of a resolution of a binding: counts it when metrics are
+         * enabled and, while a trace is running, records it with the
+         * resolution of the calling thread it is nested in.
+         */
+        template<typename T, typename... Signature>
+        struct probe_resolution {
+            probe_resolution() {
+                if constexpr (metrics_enabled) {
+                    binding_counters<T, Signature...>::resolution();
+                }
+
+                if constexpr (trace_enabled) {
+                    if (sTracing.load(std::memory_order_acquire)) {
+                        enter();
+                    }
+                }
+            }
+
+            probe_resolution(probe_resolution const &) = delete;
+
+            probe_resolution(probe_resolution &&) = delete;
+
+            ~probe_resolution() {
+                if constexpr (trace_enabled) {
+                    if (mBuffer) {
+                        exit();
+                    }
+                }
+            }
+
+        private:
+            std::shared_ptr<trace_buffer> mBuffer;
+            std::size_t mId{0};
+            std::size_t mParent{0};
+            std::chrono::steady_clock::time_point mStart;
+
+            void enter() {
+                {
+                    std::lock_guard lock{sTraceMutex};
+
+                    mBuffer = sTraceBuffer;
+                }
+
+                if (!mBuffer) {
+                    return;
+                }
+
+                mId = mBuffer->mNext.fetch_add(1, std::memory_order_relaxed);
+                mParent = trace_report::npos;
+
+                if (!sTraceFrames.empty() and sTraceFrames.back().buffer == mBuffer.get()) {
+                    mParent = sTraceFrames.back().id;
+                }
+
+                sTraceFrames.push_back({mBuffer.get(), mId});
+
+                mStart = std::chrono::steady_clock::now();
+            }
+
+            void exit() {
+                auto end = std::chrono::steady_clock::now();
+
+                sTraceFrames.pop_back();
+
+                std::lock_guard lock{mBuffer->mMutex};
+
+                mBuffer->mRecords.push_back({mId, mParent, &binding_name<T, Signature...>, std::this_thread::get_id(), mStart, end});
+            }
+        };
+    }
+
+    /*
+     * records every resolution, from any thread, while it runs; resolutions
+     * requested from inside a binding callback are recorded as children of
+     * the resolution running that callback. Requires JINJECT_TRACE, otherwise
+     * the report is empty.
+     *
+     * trace profile;
+     *
+     * UseCase useCase = get{};
+     *
+     * std::ofstream{"trace.json"} << profile.stop().to_chrome();
+     */
+    class trace {
+    public:
+        trace() {
+            if constexpr (trace_enabled) {
+                std::lock_guard lock{details::sTraceMutex};
+
+                if (details::sTraceBuffer) {
+                    throw std::runtime_error("jinject::trace already running");
+                }
+
+                mBuffer = std::make_shared<details::trace_buffer>();
+
+                details::sTraceBuffer = mBuffer;
+                details::sTracing.store(true, std::memory_order_release);
+            }
+        }
+
+        trace(trace const &) = delete;
+
+        trace(trace &&) = delete;
+
+        ~trace() {
+            stop();
+        }
+
+        /*
+         * ends the trace and returns the resolutions completed so far.
+         */
+        trace_report stop() {
+            trace_report result;
+
+            if (!mBuffer) {
+                return result;
+            }
+
+            {
+                std::lock_guard lock{details::sTraceMutex};
+
+                details::sTracing.store(false, std::memory_order_release);
+                details::sTraceBuffer.reset();
+            }
+
+            std::vector<details::trace_buffer::record> records;
+
+            {
+                std::lock_guard lock{mBuffer->mMutex};
+
+                records.swap(mBuffer->mRecords);
+            }
+
+            std::sort(records.begin(), records.end(), [](auto const &a, auto const &b) {
+                return a.id < b.id;
+            });
+
+            std::unordered_map<std::size_t, std::size_t> indexes;
+            std::vector<std::thread::id> threads;
+
+            for (auto const &record: records) {
+                auto parent = indexes.find(record.parent);
+                auto thread = std::find(threads.begin(), threads.end(), record.thread);
+
+                if (thread == threads.end()) {
+                    thread = threads.insert(threads.end(), record.thread);
+                }
+
+                indexes[record.id] = result.events.size();
+
+                result.events.push_back({
+                    record.name(),
+                    parent != indexes.end() ? parent->second : trace_report::npos,
+                    static_cast<std::size_t>(thread - threads.begin()),
+                    record.start - mBuffer->mStart,
+                    record.end - record.start
+                });
+            }
+
+            mBuffer.reset();
+
+            return result;
+        }
+
+    private:
+        std::shared_ptr<details::trace_buffer> mBuffer;
+    };
+
+    namespace details {
+        template<typename T, typename... Signature>
+        struct bind {
+            bind() {
+                details::all_binds<T>::add(&key, binding_priority<T, Signature...>::value, +[]() {
+                    return static_cast<T>(get<Signature...>{});
+                });
+            }
+
+        private:
+            static constexpr char key{};
+        };
+
+        /*
+         * mode is the publication point of a binding: registration writes the
+         * binding storage under mMutex and then stores mode with release order,
+         * so a resolver that observes mode with acquire order also observes the
+         * complete binding without taking any lock.
+         */
+        template<typename T, typename... Signature>
+        struct instantiation : public bind<T, Signature...> {
+            using type = std::remove_cvref_t<T>;
+
+            static inline std::atomic<instantiation_mode> mode = UNKNOWN;
+
+            instantiation(): bind<T, Signature...>() {
+                if (mode.load(std::memory_order_acquire) != UNKNOWN) {
+                    throw std::runtime_error("jinject::instantiation already defined");
+                }
+            }
+
+            static instantiation_mode current() {
+                return mode.load(std::memory_order_acquire);
+            }
+
+            template<typename Callback>
+            static void publish(instantiation_mode target, Callback &&callback) {
+                std::lock_guard lock{mMutex};
+
+                if (mode.load(std::memory_order_relaxed) != UNKNOWN) {
+                    throw std::runtime_error("jinject::unable to replace instantiation");
+                }
+
+                callback();
+
+                mode.store(target, std::memory_order_release);
+            }
+
+            static void promote(instantiation_mode target) {
+                mode.store(target, std::memory_order_release);
+            }
+
+        private:
+            static inline std::mutex mMutex;
+        };
+
+        struct InternalType {
+        };
+
+        struct DeferredType {
+        };
+
+        template<typename T, typename... Signature>
+        struct factory : instantiation<T, Signature...> {
+            factory(factory const &) = delete;
+
+            factory(factory &&) = delete;
+
+            factory(std::nullptr_t): instantiation<T, Signature...>() {
+            }
+
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T, Callback &>)
+            factory(Callback &&callback): instantiation<T, Signature...>() {
+                *this = std::forward<Callback>(callback);
+            }
+
+            /*
+             * binding whose callback does not always construct an instance
+             * (e.g. SHARED), so it times its constructions itself.
+             */
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T, Callback &>)
+            factory(InternalType, Callback &&callback): instantiation<T, Signature...>() {
+                instantiation<T, Signature...>::publish(FACTORY, [&]() {
+                    mCallback.assign(std::forward<Callback>(callback));
+                    mMeasured = false;
+                });
+            }
+
+            static T get() {
+                probe_construction<T, Signature...> probe{mMeasured};
+
+                return mCallback();
+            }
+
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T, Callback &>)
+            factory &operator =(Callback &&callback) {
+                instantiation<T, Signature...>::publish(FACTORY, [&]() {
+                    mCallback.assign(std::forward<Callback>(callback));
+                });
+
+                return *this;
+            }
+
+        private:
+            static inline constinit callable<T> mCallback;
+            static inline constinit bool mMeasured = true;
+        };
+
+        template<typename T>
+        struct shared_maker {
+            std::pmr::memory_resource *mResource;
+
+            template<typename... Args>
+            std::shared_ptr<T> operator()(Args &&... args) const {
+                if (mResource) {
+                    return std::allocate_shared<T>(std::pmr::polymorphic_allocator<T>{mResource}, std::forward<Args>(args)...);
+                }
+
+                return std::make_shared<T>(std::forward<Args>(args)...);
+            }
+        };
+
+        template<typename T, typename... Signature>
+            requires (NoPointer<T>)
+        struct shared {
+            shared(shared const &) = delete;
+
+            shared(shared &&) = delete;
+
+            shared(InternalType, std::pmr::memory_resource *resource = nullptr)
+                : mResource{resource} {
+            }
+
+            /*
+             * the instance lives while there are references to it; the first
+             * resolution of each alive window constructs it under mMutex and
+             * the next ones share it through a weak reference, without taking
+             * any lock.
+             */
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T *, Callback &>)
+            shared &operator =(Callback &&callback) {
+                factory<std::shared_ptr<T>, Signature...>{
+                    InternalType{}, [callback = std::forward<Callback>(callback)]() mutable {
+                        return acquire([&]() {
+                            return std::shared_ptr<T>(callback());
+                        });
+                    }
+                };
+
+                return *this;
+            }
+
+            /*
+             * constructor functor form: the callback receives a maker and
+             * forwards it the constructor arguments, so the instance and its
+             * control block are created by a single allocation (from the
+             * memory resource given to the binding, if any).
+             */
+            template<typename Callback>
+                requires (std::is_invocable_r_v<std::shared_ptr<T>, Callback &, shared_maker<T> >)
+            shared &operator =(Callback &&callback) {
+                factory<std::shared_ptr<T>, Signature...>{
+                    InternalType{}, [callback = std::forward<Callback>(callback), maker = shared_maker<T>{mResource}]() mutable {
+                        return acquire([&]() {
+                            return std::shared_ptr<T>(callback(maker));
+                        });
+                    }
+                };
+
+                return *this;
+            }
+
+        private:
+            /*
+             * weak reference of an alive window. Readers pin a generation with
+             * its counter and only read its weak reference while it is still
+             * the current one; the writer rewrites the other generation once
+             * its readers left, so no reader ever waits on a lock.
+             * (std::atomic<std::weak_ptr> is not lock-free in libstdc++.)
+             */
+            struct generation {
+                std::atomic<std::size_t> mReaders{0};
+                std::weak_ptr<T> mWeak;
+            };
+
+            static inline generation mGenerations[2];
+            static inline std::atomic<std::size_t> mCurrent{0};
+            static inline std::mutex mMutex;
+
+            std::pmr::memory_resource *mResource;
+
+            static std::shared_ptr<T> load() {
+                for (;;) {
+                    auto index = mCurrent.load();
+                    auto &current = mGenerations[index];
+
+                    current.mReaders.fetch_add(1);
+
+                    if (mCurrent.load() == index) {
+                        auto ptr = current.mWeak.lock();
+
+                        current.mReaders.fetch_sub(1);
+
+                        return ptr;
+                    }
+
+                    current.mReaders.fetch_sub(1);
+                }
+            }
+
+            template<typename Create>
+            static std::shared_ptr<T> acquire(Create &&create) {
+                if (auto ptr = load()) {
+                    return ptr;
+                }
+
+                std::lock_guard lock{mMutex};
+
+                auto index = mCurrent.load();
+
+                if (auto ptr = mGenerations[index].mWeak.lock()) {
+                    return ptr;
+                }
+
+                std::shared_ptr<T> ptr;
+
+                {
+                    probe_construction<std::shared_ptr<T>, Signature...> probe;
+
+                    ptr = create();
+                }
+
+                auto &next = mGenerations[1 - index];
+
+                while (next.mReaders.load() != 0) {
+                    std::this_thread::yield();
+                }
+
+                next.mWeak = ptr;
+
+                mCurrent.store(1 - index);
+
+                return ptr;
+            }
+        };
+
+        template<typename T, typename... Signature>
+            requires (NoPointer<T>)
+        struct scoped : instantiation<T *, Signature...> {
+            scoped(scoped const &) = delete;
+
+            scoped(scoped &&) = delete;
+
+            scoped(InternalType): instantiation<T *, Signature...>() {
+            }
+
+            static T * get() {
+                if (auto current = scope::current()) {
+                    return current->template instance<T>(sSlot, mCallback);
+                }
+
+                return nullptr;
+            }
+
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T, Callback &>)
+            scoped &operator =(Callback &&callback) {
+                instantiation<T *, Signature...>::publish(SCOPED, [&]() {
+                    mCallback.assign(std::forward<Callback>(callback));
+                    sSlot = scope::allocate_slot();
+                });
+
+                return *this;
+            }
+
+        private:
+            static inline constinit callable<T> mCallback;
+            static inline constinit std::size_t sSlot = 0;
+        };
+
+        /*
+         * one instance per thread, constructed by the first resolution of
+         * each thread and destroyed when the thread exits; the resolutions
+         * that follow are a load of a thread-local pointer.
+         */
+        template<typename T, typename... Signature>
+            requires (NoPointer<T>)
+        struct thread_instance : instantiation<T *, Signature...> {
+            thread_instance(thread_instance const &) = delete;
+
+            thread_instance(thread_instance &&) = delete;
+
+            thread_instance(InternalType): instantiation<T *, Signature...>() {
+            }
+
+            static T * get() {
+                if (auto instance = sInstance) {
+                    return instance;
+                }
+
+                return create();
+            }
+
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T, Callback &>)
+            thread_instance &operator =(Callback &&callback) {
+                instantiation<T *, Signature...>::publish(THREAD, [&]() {
+                    mCallback.assign(std::forward<Callback>(callback));
+                });
+
+                return *this;
+            }
+
+        private:
+            struct holder {
+                alignas(T) unsigned char mStorage[sizeof(T)];
+                T *mInstance{nullptr};
+
+                ~holder() {
+                    sInstance = nullptr;
+                    sFinished = true;
+
+                    if (mInstance) {
+                        mInstance->~T();
+                    }
+                }
+            };
+
+            static inline constinit callable<T> mCallback;
+            static inline thread_local constinit T *sInstance = nullptr;
+            static inline thread_local constinit bool sFinished = false;
+
+            static T * create() {
+                if (sFinished) {
+                    throw std::runtime_error("jinject::thread instance of \"" + introspection<T>::to_string() + "\" requested while its thread exits");
+                }
+
+                thread_local holder current;
+
+                if (current.mInstance == nullptr) {
+                    probe_construction<T *, Signature...> probe;
+
+                    current.mInstance = ::new(current.mStorage) T(mCallback());
+                }
+
+                sInstance = current.mInstance;
+
+                return sInstance;
+            }
+        };
+
+        /*
+         * shard of the calling thread: the cpu it runs on when the platform
+         * tells it cheaply (sched_getcpu is served by rseq on recent glibc),
+         * otherwise an index given to each thread on its first request.
+         */
+        inline std::size_t current_shard() {
+#if defined(__linux__)
+            if (auto cpu = sched_getcpu(); cpu >= 0) {
+                return static_cast<std::size_t>(cpu);
+            }
+#endif
+
+            static std::atomic<std::size_t> sNext{0};
+
+            thread_local std::size_t const index = sNext.fetch_add(1, std::memory_order_relaxed);
+
+            return index;
+        }
+
+        /*
+         * N instances, each on its own cache lines, constructed when the
+         * binding is declared; a resolution returns the shard of the cpu (or
+         * thread) of the caller, so concurrent users rarely share a line.
+         * Threads may still meet on a shard, T must be thread-safe.
+         */
+        template<typename T, typename... Signature>
+            requires (NoPointer<T>)
+        struct sharded : instantiation<T *, Signature...> {
+            static constexpr std::size_t cache_line = 64;
+
+            sharded(sharded const &) = delete;
+
+            sharded(sharded &&) = delete;
+
+            sharded(InternalType, std::size_t count = std::thread::hardware_concurrency())
+                : instantiation<T *, Signature...>(), mCount{std::bit_ceil(std::max<std::size_t>(count, 1))} {
+            }
+
+            static T * get() {
+                return &sStorage.mShards[current_shard() & (sStorage.mCount - 1)].mValue;
+            }
+
+            template<typename Visitor>
+            static void visit(Visitor &&visitor) {
+                for (std::size_t i = 0; i < sStorage.mCount; i++) {
+                    visitor(sStorage.mShards[i].mValue);
+                }
+            }
+
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T, Callback &>)
+            sharded &operator =(Callback &&callback) {
+                instantiation<T *, Signature...>::publish(SHARDED, [&]() {
+                    sStorage.create(mCount, callback);
+                });
+
+                return *this;
+            }
+
+        private:
+            struct alignas(std::max(cache_line, alignof(T))) shard {
+                T mValue;
+            };
+
+            struct storage {
+                shard *mShards{nullptr};
+                std::size_t mCount{0};
+
+                constexpr storage() = default;
+
+                ~storage() {
+                    for (std::size_t i = mCount; i > 0; i--) {
+                        mShards[i - 1].~shard();
+                    }
+
+                    ::operator delete(mShards, std::align_val_t{alignof(shard)});
+                }
+
+                template<typename Callback>
+                void create(std::size_t count, Callback &callback) {
+                    auto shards = static_cast<shard *>(::operator new(count*sizeof(shard), std::align_val_t{alignof(shard)}));
+                    std::size_t i = 0;
+
+                    try {
+                        for (; i < count; i++) {
+                            probe_construction<T *, Signature...> probe;
+
+                            ::new(&shards[i]) shard{callback()};
+                        }
+                    } catch (...) {
+                        while (i > 0) {
+                            shards[--i].~shard();
+                        }
+
+                        ::operator delete(shards, std::align_val_t{alignof(shard)});
+
+                        throw;
+                    }
+
+                    mShards = shards;
+                    mCount = count;
+                }
+            };
+
+            static inline constinit storage sStorage;
+
+            std::size_t mCount;
+        };
 
+        /*
+         * factory whose callback is slow (i/o, loading) and that inject_async
+         * runs on its own thread; get{} still calls it synchronously.
+         */
         template<typename T, typename... Signature>
-        struct factory : instantiation<T, Signature...> {
-            factory(factory const &) = delete;
-
-            factory(factory &&) = delete;
+        struct async_factory {
+            async_factory(async_factory const &) = delete;
 
-            template<typename... Args>
-            factory(std::function<T()> const &callback): instantiation<T, Signature...>() {
-                if (callback) {
-                    mCallback = callback;
+            async_factory(async_factory &&) = delete;
 
-                    instantiation<T, Signature...>::mode = FACTORY;
-                }
+            async_factory(InternalType) {
             }
 
-            static T get() {
-                return mCallback();
+            static bool asynchronous() {
+                return sAsynchronous.load(std::memory_order_acquire);
             }
 
-            factory &operator =(std::function<T()> const &callback) {
-                if (instantiation<std::shared_ptr<T>, Signature...>::mode != UNKNOWN) {
-                    throw std::runtime_error("jinject::unable to replace instantiation");
-                }
-
-                mCallback = callback;
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T, Callback &>)
+            async_factory &operator =(Callback &&callback) {
+                factory<T, Signature...>{std::forward<Callback>(callback)};
 
-                instantiation<T, Signature...>::mode = FACTORY;
+                sAsynchronous.store(true, std::memory_order_release);
 
                 return *this;
             }
 
         private:
-            static inline std::function<T()> mCallback;
-        };
-
-        struct InternalType {
+            static inline std::atomic<bool> sAsynchronous{false};
         };
 
         template<typename T, typename... Signature>
             requires (NoPointer<T>)
-        struct shared {
-            shared(shared const &) = delete;
+        struct pool_unique {
+            pool_unique(pool_unique const &) = delete;
 
-            shared(shared &&) = delete;
+            pool_unique(pool_unique &&) = delete;
 
-            shared(InternalType) {
+            pool_unique(InternalType) {
             }
 
-            shared &operator =(std::function<T*()> const &callback) {
-                std::weak_ptr<T, Signature...> weak;
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T, Callback &>)
+            pool_unique &operator =(Callback &&callback) {
+                factory<pool_ptr<T>, Signature...>{
+                    [callback = std::forward<Callback>(callback)]() mutable {
+                        using pool = typename allocation_policy<T>::type;
 
-                factory<std::shared_ptr<T>, Signature...>{
-                    [=]() mutable {
-                        if (auto ptr = weak.lock()) {
-                            return ptr;
+                        auto storage = pool::allocate();
+
+                        try {
+                            return pool_ptr<T>{::new(storage) T(callback())};
+                        } catch (...) {
+                            pool::release(storage);
+
+                            throw;
                         }
+                    }
+                };
+
+                return *this;
+            }
+        };
+
+        template<typename T, typename... Signature>
+            requires (NoPointer<T>)
+        struct pooled {
+            pooled(pooled const &) = delete;
 
-                        auto ptr = std::shared_ptr<T, Signature...>(callback());
+            pooled(pooled &&) = delete;
 
-                        weak = ptr;
+            pooled(InternalType) {
+            }
 
-                        return ptr;
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T, Callback &>)
+            pooled &operator =(Callback &&callback) {
+                factory<pooled_ptr<T>, Signature...>{
+                    InternalType{}, [callback = std::forward<Callback>(callback)]() mutable {
+                        return pooled_ptr<T>{
+                            object_pool<T>::acquire([&]() {
+                                probe_construction<pooled_ptr<T>, Signature...> probe;
+
+                                return new T(callback());
+                            })
+                        };
                     }
                 };
 
@@ -299,7 +2978,6 @@ namespace jinject {
             }
         };
 
-
         template<typename T, typename... Signature>
             requires (NoPointer<T>)
         struct unique {
@@ -321,16 +2999,6 @@ namespace jinject {
             }
         };
 
-        std::string demangle(char const *name) {
-            int status = -999;
-
-            std::unique_ptr<char, void(*)(void *)> res{
-                abi::__cxa_demangle(name, NULL, NULL, &status), std::free
-            };
-
-            return (status == 0) ? res.get() : name;
-        }
-
         template<typename T, typename... Signature>
         struct single : instantiation<T, Signature...> {
             single(single const &) = delete;
@@ -338,86 +3006,174 @@ namespace jinject {
             single(single &&) = delete;
         };
 
+        /*
+         * instance of a SINGLE binding: constructed when declared or, when
+         * deferred, by the first resolution (and then published as SINGLE).
+         */
         template<typename T, typename... Signature>
-        struct single<T *, Signature...> : instantiation<T *, Signature...> {
-            single(single const &) = delete;
+        struct single_instance : instantiation<T, Signature...> {
+            single_instance(): instantiation<T, Signature...>() {
+            }
 
-            single(single &&) = delete;
+            static T get() {
+                return mInstance;
+            }
 
-            template<typename... Args>
-            single(std::function<T *()> const &callback): instantiation<T *, Signature...>() {
-                if (callback) {
-                    mInstance = callback();
+            static void construct() {
+                construction_request request{sNode};
+                construction_lock lock{sNode, mMutex};
 
-                    instantiation<T *, Signature...>::mode = SINGLE;
+                if (instantiation<T, Signature...>::current() != DEFERRED) {
+                    return;
                 }
-            }
 
-            static T * get() {
-                return mInstance;
+                {
+                    construction_build build{sNode};
+                    probe_construction<T, Signature...> probe;
+
+                    mInstance = mCallback();
+                }
+
+                mCallback.reset();
+
+                instantiation<T, Signature...>::promote(SINGLE);
             }
 
-            single &operator =(std::function<T*()> const &callback) {
-                if (instantiation<std::shared_ptr<T>, Signature...>::mode != UNKNOWN) {
-                    throw std::runtime_error("jinject::unable to replace instantiation");
+        protected:
+            static inline T mInstance = {};
+
+            template<typename Callback>
+            static void assign(Callback &&callback, bool deferred) {
+                if (deferred) {
+                    instantiation<T, Signature...>::publish(DEFERRED, [&]() {
+                        mCallback.assign(std::forward<Callback>(callback));
+                    });
+
+                    if (auto current = warmup::current()) {
+                        current->add(sNode);
+                    }
+
+                    return;
                 }
 
-                mInstance = callback();
+                instantiation<T, Signature...>::publish(SINGLE, [&]() {
+                    probe_construction<T, Signature...> probe;
+
+                    mInstance = callback();
+                });
+            }
+
+        private:
+            static inline constinit callable<T> mCallback;
+            static inline std::mutex mMutex;
+            static inline char const mKey{};
+            static inline deferred_node const sNode{&mKey, &introspection<T>::to_string, &construct};
+        };
+
+        template<typename T, typename... Signature>
+        struct single<T *, Signature...> : single_instance<T *, Signature...> {
+            single(single const &) = delete;
+
+            single(single &&) = delete;
+
+            single(std::nullptr_t) {
+            }
+
+            single(DeferredType)
+                : mDeferred{true} {
+            }
+
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T *, Callback &>)
+            single(Callback &&callback) {
+                *this = std::forward<Callback>(callback);
+            }
 
-                instantiation<T *, Signature...>::mode = SINGLE;
+            template<typename Callback>
+                requires (std::is_invocable_r_v<T *, Callback &>)
+            single &operator =(Callback &&callback) {
+                single_instance<T *, Signature...>::assign(std::forward<Callback>(callback), mDeferred or warmup::current() != nullptr);
 
                 return *this;
             }
 
         private:
-            static inline T *mInstance = {};
+            bool mDeferred{JINJECT_DEFERRED_SINGLE != 0};
         };
 
         template<typename T, typename... Signature>
-        struct single<std::shared_ptr<T>, Signature...> : instantiation<std::shared_ptr<T>, Signature...> {
+        struct single<std::shared_ptr<T>, Signature...> : single_instance<std::shared_ptr<T>, Signature...> {
             single(single const &) = delete;
 
             single(single &&) = delete;
 
-            template<typename... Args>
-            single(std::function<std::shared_ptr<T>()> callback): instantiation<std::shared_ptr<T>, Signature...>() {
-                if (callback) {
-                    mInstance = callback();
-
-                    instantiation<std::shared_ptr<T>, Signature...>::mode = SINGLE;
-                }
+            single(std::nullptr_t) {
             }
 
-            static std::shared_ptr<T> const get() {
-                return mInstance;
+            single(DeferredType)
+                : mDeferred{true} {
             }
 
-            single &operator =(std::function<std::shared_ptr<T>()> const &callback) {
-                if (instantiation<std::shared_ptr<T>, Signature...>::mode != UNKNOWN) {
-                    throw std::runtime_error("jinject::unable to replace instantiation");
-                }
+            template<typename Callback>
+                requires (std::is_invocable_r_v<std::shared_ptr<T>, Callback &>)
+            single(Callback &&callback) {
+                *this = std::forward<Callback>(callback);
+            }
 
-                mInstance = callback();
+            static T * pointer() {
+                return single_instance<std::shared_ptr<T>, Signature...>::mInstance.get();
+            }
 
-                instantiation<std::shared_ptr<T>, Signature...>::mode = SINGLE;
+            template<typename Callback>
+                requires (std::is_invocable_r_v<std::shared_ptr<T>, Callback &>)
+            single &operator =(Callback &&callback) {
+                single_instance<std::shared_ptr<T>, Signature...>::assign(std::forward<Callback>(callback), mDeferred or warmup::current() != nullptr);
 
                 return *this;
             }
 
         private:
-            static inline std::shared_ptr<T> mInstance;
+            bool mDeferred{JINJECT_DEFERRED_SINGLE != 0};
         };
     }
 
+    namespace details {
+        /*
+         * name of T taken at compile time from the signature of this function,
+         * e.g. "constexpr std::string_view jinject::details::type_name() [with T = int; ...]"
+         */
+        template<typename T>
+        constexpr std::string_view type_name() {
+            std::string_view function = __PRETTY_FUNCTION__;
+
+            auto start = function.find("T = ") + 4;
+            auto end = function.find(';', start);
+
+            if (end == std::string_view::npos) {
+                end = function.rfind(']');
+            }
+
+            return function.substr(start, end - start);
+        }
+    }
+
     template<typename T>
     struct introspection {
+        static constexpr std::string_view name() {
+            return details::type_name<T>();
+        }
+
         static std::string to_string() {
-            return details::demangle(typeid(T).name());
+            return std::string{name()};
         }
     };
 
     template<typename T>
     struct introspection<T *> {
+        static constexpr std::string_view name() {
+            return details::type_name<T *>();
+        }
+
         static std::string to_string() {
             return introspection<T>::to_string() + "*";
         }
@@ -425,6 +3181,10 @@ namespace jinject {
 
     template<typename T>
     struct introspection<std::shared_ptr<T> > {
+        static constexpr std::string_view name() {
+            return details::type_name<std::shared_ptr<T> >();
+        }
+
         static std::string to_string() {
             return "std::shared_ptr<" + introspection<T>::to_string() + ">";
         }
@@ -432,36 +3192,100 @@ namespace jinject {
 
     template<typename T>
     struct introspection<std::unique_ptr<T> > {
+        static constexpr std::string_view name() {
+            return details::type_name<std::unique_ptr<T> >();
+        }
+
         static std::string to_string() {
             return "std::unique_ptr<" + introspection<T>::to_string() + ">";
         }
     };
 
-    template<typename... Signature>
-    struct get {
-        get() = default;
+    enum resolution_status {
+        UNDEFINED_INSTANTIATION,
+        INVALID_SINGLE,
+        NO_ACTIVE_SCOPE
+    };
 
-        template<typename T>
-        operator T() const {
-            if (details::instantiation<T, Signature...>::mode == SINGLE) {
-                if constexpr (SharedPtrConcept<T>) {
-                    return details::single<T, Signature...>::get();
+    /*
+     * failure of a non-throwing resolution; the message is only built when
+     * to_string() is called.
+     */
+    struct resolution_error {
+        resolution_status status;
+        std::string (*type)();
+
+        std::string to_string() const {
+            if (status == INVALID_SINGLE) {
+                return "jinject::single instantiation must use shared smart pointer";
+            }
+
+            if (status == NO_ACTIVE_SCOPE) {
+                return "jinject::scoped instantiation of \"" + type() + "\" requires an active scope";
+            }
+
+            return "jinject::undefined instantiation of \"" + type() + "\"";
+        }
+    };
+
+    namespace details {
+        template<typename T, typename... Signature>
+        std::expected<T, resolution_error> resolve() {
+            probe_resolution<T, Signature...> probe;
+
+            auto mode = instantiation<T, Signature...>::current();
+
+            if (mode == SINGLE) {
+                if constexpr (SharedPtrConcept<T> or PointerConcept<T>) {
+                    return single<T, Signature...>::get();
+                } else {
+                    return std::unexpected{resolution_error{INVALID_SINGLE, &introspection<T>::to_string}};
+                }
+            } else if (mode == DEFERRED) {
+                if constexpr (SharedPtrConcept<T> or PointerConcept<T>) {
+                    single<T, Signature...>::construct();
+
+                    return single<T, Signature...>::get();
                 } else {
-                    if constexpr (PointerConcept<T>) {
-                        return details::single<T, Signature...>::get();
+                    return std::unexpected{resolution_error{INVALID_SINGLE, &introspection<T>::to_string}};
+                }
+            } else if (mode == FACTORY) {
+                return factory<T, Signature...>::get();
+            } else if (mode == SCOPED) {
+                if constexpr (PointerConcept<T>) {
+                    if (auto instance = scoped<std::remove_pointer_t<T>, Signature...>::get()) {
+                        return instance;
                     }
 
-                    throw std::runtime_error("jinject::single instantiation must use shared smart pointer");
+                    return std::unexpected{resolution_error{NO_ACTIVE_SCOPE, &introspection<T>::to_string}};
+                }
+            } else if (mode == THREAD) {
+                if constexpr (PointerConcept<T>) {
+                    return thread_instance<std::remove_pointer_t<T>, Signature...>::get();
+                }
+            } else if (mode == SHARDED) {
+                if constexpr (PointerConcept<T>) {
+                    return sharded<std::remove_pointer_t<T>, Signature...>::get();
                 }
-            } else if (details::instantiation<T, Signature...>::mode == FACTORY) {
-                return details::factory<T, Signature...>::get();
             }
 
-            std::ostringstream o;
+            return std::unexpected{resolution_error{UNDEFINED_INSTANTIATION, &introspection<T>::to_string}};
+        }
+    }
+
+    template<typename... Signature>
+    struct get {
+        get() = default;
+
+        template<typename T>
+        operator T() const {
+            auto result = details::resolve<T, Signature...>();
 
-            o << "jinject::undefined instantiation of " << std::quoted(introspection<T>::to_string());
+            if (!result) {
+                throw std::runtime_error(result.error().to_string());
+            }
 
-            throw std::runtime_error(o.str());
+            return std::move(*result);
         }
     };
 
@@ -470,29 +3294,272 @@ namespace jinject {
         return static_cast<T>(get<Signature...>{});
     }
 
+    /*
+     * borrows the instance of a SINGLE binding of T, bound either as
+     * std::shared_ptr<T> or as T *, without touching its reference count.
+     * Single instances are never replaced nor released while the program
+     * runs, so the reference stays valid until static destruction.
+     */
+    template<typename T, typename... Signature>
+    T & borrow() {
+        switch (details::instantiation<std::shared_ptr<T>, Signature...>::current()) {
+            case DEFERRED:
+                details::single<std::shared_ptr<T>, Signature...>::construct();
+                [[fallthrough]];
+            case SINGLE: {
+                details::probe_resolution<std::shared_ptr<T>, Signature...> probe;
+
+                return *details::single<std::shared_ptr<T>, Signature...>::pointer();
+            }
+            default:
+                break;
+        }
+
+        switch (details::instantiation<T *, Signature...>::current()) {
+            case DEFERRED:
+                details::single<T *, Signature...>::construct();
+                [[fallthrough]];
+            case SINGLE: {
+                details::probe_resolution<T *, Signature...> probe;
+
+                return *details::single<T *, Signature...>::get();
+            }
+            default:
+                break;
+        }
+
+        throw std::runtime_error("jinject::borrow requires a single instantiation of \"" + introspection<T>::to_string() + "\"");
+    }
+
+    /*
+     * calls visitor with each shard of a SHARDED binding of T, e.g. to sum
+     * the counters kept by every shard.
+     */
+    template<typename T, typename... Signature, typename Visitor>
+    void visit_shards(Visitor &&visitor) {
+        if (details::instantiation<T *, Signature...>::current() != SHARDED) {
+            throw std::runtime_error("jinject::visit_shards requires a sharded instantiation of \"" + introspection<T>::to_string() + "\"");
+        }
+
+        details::sharded<T, Signature...>::visit(std::forward<Visitor>(visitor));
+    }
+
+    /*
+     * resolves T without throwing when there is no binding for it; errors
+     * thrown by the binding callback itself are propagated.
+     */
+    template<typename T, typename... Signature>
+    [[nodiscard]] std::expected<T, resolution_error> try_inject() {
+        return details::resolve<T, Signature...>();
+    }
+
     template<typename T, typename... Signature>
     [[nodiscard]] std::expected<T, std::string> inject_by() {
         try {
-            return {static_cast<T>(get<Signature...>{})};
+            auto result = details::resolve<T, Signature...>();
+
+            if (!result) {
+                return std::unexpected{result.error().to_string()};
+            }
+
+            return {std::move(*result)};
         } catch (std::runtime_error &e) {
             return std::unexpected{e.what()};
         }
     };
 
+    /*
+     * resolves T like inject_by, on a new thread when T has an ASYNC_FACTORY
+     * binding, so independent slow dependencies are constructed concurrently;
+     * for the other bindings the result is resolved now and returned ready.
+     *
+     * auto model = inject_async<Model>();
+     * auto socket = inject_async<Socket>();
+     *
+     * UseCase useCase{model.get().value(), socket.get().value()};
+     */
+    template<typename T, typename... Signature>
+    [[nodiscard]] std::future<std::expected<T, std::string> > inject_async() {
+        if (details::async_factory<T, Signature...>::asynchronous()) {
+            return std::async(std::launch::async, &inject_by<T, Signature...>);
+        }
+
+        std::promise<std::expected<T, std::string> > result;
+
+        result.set_value(inject_by<T, Signature...>());
+
+        return result.get_future();
+    }
+
+    template<typename Module, typename... Signature>
+    struct get_from;
+
+    /*
+     * compile-time bindings: the callback is part of the binding type, so a
+     * resolution through a static_module is a direct (and inlinable) call.
+     * Callbacks take no arguments or a get_from<Module> to resolve their own
+     * dependencies from the same module.
+     *
+     * using core = static_module<
+     *     static_factory<int, []() { return 42; }>,
+     *     static_single<IFoo *, [](auto get) { return new Foo{get}; }>
+     * >;
+     *
+     * IFoo *foo = get_from<core>{};
+     */
+    template<typename T, auto Callback, typename... Signature>
+    struct static_factory {
+        using type = T;
+        using signature = std::tuple<Signature...>;
+
+        template<typename Module>
+        static T get() {
+            if constexpr (std::is_invocable_v<decltype(Callback), get_from<Module> >) {
+                return Callback(get_from<Module>{});
+            } else {
+                return Callback();
+            }
+        }
+    };
+
+    template<typename T, auto Callback, typename... Signature>
+        requires (SharedPtrConcept<T> or PointerConcept<T>)
+    struct static_single {
+        using type = T;
+        using signature = std::tuple<Signature...>;
+
+        template<typename Module>
+        static T get() {
+            static T instance = static_factory<T, Callback>::template get<Module>();
+
+            return instance;
+        }
+    };
+
+    namespace details {
+        template<typename T, typename Signature, typename... Bindings>
+        struct find_binding {
+            using type = void;
+        };
+
+        template<typename T, typename Signature, typename Binding, typename... Bindings>
+        struct find_binding<T, Signature, Binding, Bindings...>
+            : std::conditional_t<std::is_same_v<typename Binding::type, T> and std::is_same_v<typename Binding::signature, Signature>,
+                std::type_identity<Binding>,
+                find_binding<T, Signature, Bindings...> > {
+        };
+    }
+
+    template<typename... Bindings>
+    struct static_module {
+        template<typename T, typename... Signature>
+        static constexpr bool contains = not std::is_void_v<typename details::find_binding<T, std::tuple<Signature...>, Bindings...>::type>;
+
+        template<typename Module, typename T, typename... Signature>
+        static T get() {
+            if constexpr (contains<T, Signature...>) {
+                return details::find_binding<T, std::tuple<Signature...>, Bindings...>::type::template get<Module>();
+            } else {
+                static_assert(contains<T, Signature...>, "jinject::static_module has no binding for the requested type");
+            }
+        }
+    };
+
+    template<typename Module, typename... Signature>
+    struct get_from {
+        get_from() = default;
+
+        template<typename T>
+        operator T() const {
+            return Module::template get<Module, T, Signature...>();
+        }
+    };
+
+    template<typename Module, typename T, typename... Signature>
+    decltype(auto) inject_from() {
+        return static_cast<T>(get_from<Module, Signature...>{});
+    }
+
+    /*
+     * resolves T on the first access and keeps it; the next accesses are a
+     * single acquire load and return a reference to the kept value. A lazy
+     * may be moved (e.g. into containers) while no other thread accesses it.
+     */
     template<typename T, typename... Signature>
     struct lazy {
-        T operator()() {
-            std::call_once(mFlag,
-                           [this]() {
-                               mReference = get<Signature...>{};
-                           });
+        lazy() = default;
+
+        lazy(lazy &&other) {
+            *this = std::move(other);
+        }
+
+        lazy & operator=(lazy &&other) {
+            if (this != &other) {
+                mValue = std::move(other.mValue);
+                mState.store(other.mState.load(std::memory_order_acquire) == READY ? READY : EMPTY, std::memory_order_release);
+
+                other.mValue.reset();
+                other.mState.store(EMPTY, std::memory_order_release);
+            }
 
-            return mReference;
+            return *this;
+        }
+
+        T const & operator()() const {
+            if (mState.load(std::memory_order_acquire) == READY) {
+                return *mValue;
+            }
+
+            return initialize();
+        }
+
+        T const * get() const {
+            return &(*this)();
         }
 
     private:
-        T mReference;
-        std::once_flag mFlag;
+        enum state : uint8_t {
+            EMPTY,
+            BUSY,
+            READY
+        };
+
+        mutable std::atomic<uint8_t> mState{EMPTY};
+        mutable std::optional<T> mValue;
+
+        T const & initialize() const {
+            for (;;) {
+                uint8_t current = EMPTY;
+
+                if (mState.compare_exchange_strong(current, BUSY, std::memory_order_acquire)) {
+                    try {
+                        auto result = details::resolve<T, Signature...>();
+
+                        if (!result) {
+                            throw std::runtime_error(result.error().to_string());
+                        }
+
+                        mValue.emplace(std::move(*result));
+                    } catch (...) {
+                        mState.store(EMPTY, std::memory_order_release);
+                        mState.notify_all();
+
+                        throw;
+                    }
+
+                    mState.store(READY, std::memory_order_release);
+                    mState.notify_all();
+
+                    return *mValue;
+                }
+
+                if (current == READY) {
+                    return *mValue;
+                }
+
+                mState.wait(BUSY, std::memory_order_acquire);
+            }
+        }
     };
 
     template<typename T, typename... Signature>
@@ -532,21 +3599,25 @@ namespace jinject {
 
         template<typename T>
         operator T *() const {
-            struct internal_class : public Base, public T {
-            };
-
-            return reinterpret_cast<T *>(static_cast<Base *>(new internal_class{}));
+            return reinterpret_cast<T *>(static_cast<Base *>(new internal_class<T>{}));
         }
 
         template<typename T>
         operator std::shared_ptr<T>() const {
-            return std::shared_ptr<T>{static_cast<T *>(*this)};
+            auto ptr = std::make_shared<internal_class<T> >();
+
+            return std::shared_ptr<T>{ptr, reinterpret_cast<T *>(static_cast<Base *>(ptr.get()))};
         }
 
         template<typename T>
         operator std::unique_ptr<T>() const {
             return std::unique_ptr<T>{static_cast<T *>(*this)};
         }
+
+    private:
+        template<typename T>
+        struct internal_class : public Base, public T {
+        };
     };
 
     template<typename... Params>
@@ -569,14 +3640,41 @@ namespace jinject {
 #define _T(TEXT, ...) \
     (std::string{get_typed<TEXT, ##__VA_ARGS__>{}})
 
+#define _TV(TEXT, ...) \
+    (get_typed<TEXT, ##__VA_ARGS__>{}.view())
+
 #define FACTORY(T, ...) \
     details::factory<T, ##__VA_ARGS__> { nullptr } = [=]() -> T
 
+#define ASYNC_FACTORY(T, ...) \
+    details::async_factory<T, ##__VA_ARGS__> {details::InternalType{}} = [=]() -> T
+
 #define SHARED(T, ...) \
     details::shared<T, ##__VA_ARGS__> {details::InternalType{}} = []() -> T*
 
+#define MAKE_SHARED(T, ...) \
+    details::shared<T, ##__VA_ARGS__> {details::InternalType{}} = [](auto make) -> std::shared_ptr<T>
+
 #define UNIQUE(T, ...) \
     details::unique<T, ##__VA_ARGS__> {details::InternalType{}} = []() -> T*
 
+#define POOL_UNIQUE(T, ...) \
+    details::pool_unique<T, ##__VA_ARGS__> {details::InternalType{}} = [=]() -> T
+
+#define POOLED(T, ...) \
+    details::pooled<T, ##__VA_ARGS__> {details::InternalType{}} = [=]() -> T
+
+#define SCOPED(T, ...) \
+    details::scoped<T, ##__VA_ARGS__> {details::InternalType{}} = [=]() -> T
+
+#define THREAD_LOCAL(T, ...) \
+    details::thread_instance<T, ##__VA_ARGS__> {details::InternalType{}} = [=]() -> T
+
+#define SHARDED(T, ...) \
+    details::sharded<T, ##__VA_ARGS__> {details::InternalType{}} = [=]() -> T
+
 #define SINGLE(T, ...) \
   details::single<T, ##__VA_ARGS__> { nullptr } = [=]() -> T
+
+#define DEFERRED_SINGLE(T, ...) \
+  details::single<T, ##__VA_ARGS__> { details::DeferredType{} } = [=]() -> T
@@ -0,0 +1,779 @@
+#include "jinject/jinject.h"
+
+#include <benchmark/benchmark.h>
+
+#include <filesystem>
+#include <fstream>
+
+using namespace jinject;
+
+struct FactoryBench {
+    int mValue{0};
+};
+
+struct SingleBench {
+    int mValue{0};
+};
+
+struct SharedBench {
+    int mValue{0};
+};
+
+struct UniqueBench {
+    int mValue{0};
+};
+
+struct ThreadBench {
+    int mValue{0};
+};
+
+struct CounterBench {
+    std::atomic<long> mValue{0};
+};
+
+struct ShardedCounterBench {
+    std::atomic<long> mValue{0};
+};
+
+struct PoolBench {
+    char mBuffer[256];
+};
+
+struct CodecBench {
+    std::vector<char> mBuffer = std::vector<char>(4096);
+    std::size_t mSize{0};
+
+    void reset() {
+        mSize = 0;
+    }
+};
+
+struct SignatureBench {
+};
+
+template<int N>
+struct AllBench {
+    int mValue{N};
+};
+
+struct ServiceBench {
+    ServiceBench(FactoryBench factory, std::shared_ptr<SingleBench> single)
+        : mFactory{factory}, mSingle{std::move(single)} {
+    }
+
+    FactoryBench mFactory;
+    std::shared_ptr<SingleBench> mSingle;
+};
+
+enum bench_locale {
+    BENCH_PT_br
+};
+
+using StaticBench = static_module<
+    static_factory<FactoryBench, []() { return FactoryBench{42}; }>
+>;
+
+template<int N, int... I>
+void LoadAllModule(std::integer_sequence<int, I...>) {
+    ((FACTORY(AllBench<N>, std::integral_constant<int, I>) {
+        return AllBench<N>{};
+    }), ...);
+}
+
+static void LoadModules() {
+    static std::once_flag flag;
+
+    std::call_once(flag,
+                   []() {
+                       NAMED("bench.url", "https://google.com");
+                       NAMED("bench.timeout", 1500);
+
+                       auto path = std::filesystem::temp_directory_path()/"jinject_bench.conf";
+
+                       {
+                           std::ofstream file{path};
+
+                           for (int i = 0; i < 10000; i++) {
+                               file << "bench.key" << i << " = value" << i << "\n";
+                           }
+
+                           file << "bench.mapped = https://google.com\n";
+                       }
+
+                       load_named(path.string());
+
+                       TYPED("Hello, bench !")
+                           .add(BENCH_PT_br, "Oi, bench !");
+
+                       FACTORY(FactoryBench) {
+                           return FactoryBench{42};
+                       };
+
+                       FACTORY(FactoryBench*) {
+                           return new FactoryBench{42};
+                       };
+
+                       FACTORY(std::shared_ptr<FactoryBench>) {
+                           return std::make_shared<FactoryBench>(42);
+                       };
+
+                       FACTORY(std::unique_ptr<FactoryBench>) {
+                           return std::make_unique<FactoryBench>(42);
+                       };
+
+                       FACTORY(FactoryBench, SignatureBench) {
+                           return FactoryBench{21};
+                       };
+
+                       SINGLE(SingleBench*) {
+                           return new SingleBench{42};
+                       };
+
+                       SINGLE(std::shared_ptr<SingleBench>) {
+                           return std::make_shared<SingleBench>(42);
+                       };
+
+                       SHARED(SharedBench) {
+                           return new SharedBench{42};
+                       };
+
+                       UNIQUE(UniqueBench) {
+                           return new UniqueBench{42};
+                       };
+
+                       THREAD_LOCAL(ThreadBench) {
+                           return ThreadBench{42};
+                       };
+
+                       SINGLE(CounterBench*) {
+                           return new CounterBench{};
+                       };
+
+                       SHARDED(ShardedCounterBench) {
+                           return ShardedCounterBench{};
+                       };
+
+                       UNIQUE(PoolBench) {
+                           return new PoolBench{};
+                       };
+
+                       POOL_UNIQUE(PoolBench) {
+                           return PoolBench{};
+                       };
+
+                       UNIQUE(CodecBench) {
+                           return new CodecBench{};
+                       };
+
+                       POOLED(CodecBench) {
+                           return CodecBench{};
+                       };
+
+                       LoadAllModule<8>(std::make_integer_sequence<int, 8>{});
+                       LoadAllModule<64>(std::make_integer_sequence<int, 64>{});
+                   });
+}
+
+// factory callback storage
+static void BM_FactoryHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        FactoryBench value{42};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactoryHandWired);
+
+static void BM_FactoryStdFunction(benchmark::State &state) {
+    std::function<FactoryBench()> callback = []() {
+        return FactoryBench{42};
+    };
+
+    benchmark::DoNotOptimize(callback);
+
+    for (auto _: state) {
+        FactoryBench value = callback();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactoryStdFunction);
+
+static void BM_FactoryCallable(benchmark::State &state) {
+    details::callable<FactoryBench> callback;
+
+    callback.assign([]() {
+        return FactoryBench{42};
+    });
+
+    benchmark::DoNotOptimize(callback);
+
+    for (auto _: state) {
+        FactoryBench value = callback();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactoryCallable);
+
+// factory resolution
+static void BM_FactoryInject(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        FactoryBench value = inject<FactoryBench>();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactoryInject);
+
+static void BM_FactorySignature(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        FactoryBench value = get<SignatureBench>{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactorySignature);
+
+static void BM_FactoryStatic(benchmark::State &state) {
+    for (auto _: state) {
+        FactoryBench value = get_from<StaticBench>{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactoryStatic);
+
+static void BM_FactoryPointerHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        FactoryBench *value = new FactoryBench{42};
+
+        benchmark::DoNotOptimize(value);
+
+        delete value;
+    }
+}
+BENCHMARK(BM_FactoryPointerHandWired);
+
+static void BM_FactoryPointer(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        FactoryBench *value = get{};
+
+        benchmark::DoNotOptimize(value);
+
+        delete value;
+    }
+}
+BENCHMARK(BM_FactoryPointer);
+
+static void BM_FactorySharedHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        auto value = std::make_shared<FactoryBench>(42);
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactorySharedHandWired);
+
+static void BM_FactoryShared(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        std::shared_ptr<FactoryBench> value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactoryShared);
+
+static void BM_FactoryUniqueHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        auto value = std::make_unique<FactoryBench>(42);
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactoryUniqueHandWired);
+
+static void BM_FactoryUnique(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        std::unique_ptr<FactoryBench> value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_FactoryUnique);
+
+// single, shared and unique instantiation
+static void BM_SinglePointerHandWired(benchmark::State &state) {
+    static SingleBench *instance = new SingleBench{42};
+
+    for (auto _: state) {
+        SingleBench *value = instance;
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_SinglePointerHandWired);
+
+static void BM_SinglePointer(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        SingleBench *value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_SinglePointer);
+
+static void BM_SingleSharedHandWired(benchmark::State &state) {
+    static auto instance = std::make_shared<SingleBench>(42);
+
+    for (auto _: state) {
+        std::shared_ptr<SingleBench> value = instance;
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_SingleSharedHandWired);
+
+static void BM_SingleGet(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        std::shared_ptr<SingleBench> value = get{};
+
+        benchmark::DoNotOptimize(value->mValue);
+    }
+}
+BENCHMARK(BM_SingleGet)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_SingleBorrow(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        SingleBench &value = borrow<SingleBench>();
+
+        benchmark::DoNotOptimize(value.mValue);
+    }
+}
+BENCHMARK(BM_SingleBorrow)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_SharedHandWired(benchmark::State &state) {
+    static auto instance = std::make_shared<SharedBench>(42);
+    std::weak_ptr<SharedBench> weak = instance;
+
+    for (auto _: state) {
+        auto value = weak.lock();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_SharedHandWired);
+
+static void BM_Shared(benchmark::State &state) {
+    LoadModules();
+
+    std::shared_ptr<SharedBench> alive = get{};
+
+    for (auto _: state) {
+        std::shared_ptr<SharedBench> value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_Shared);
+
+static void BM_UniqueHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        auto value = std::make_unique<UniqueBench>(42);
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_UniqueHandWired);
+
+static void BM_Unique(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        std::unique_ptr<UniqueBench> value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_Unique);
+
+static void BM_ThreadLocalHandWired(benchmark::State &state) {
+    thread_local ThreadBench instance{42};
+
+    for (auto _: state) {
+        ThreadBench *value = &instance;
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_ThreadLocalHandWired)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_ThreadLocal(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        ThreadBench *value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_ThreadLocal)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_CounterHandWired(benchmark::State &state) {
+    static CounterBench counter;
+
+    for (auto _: state) {
+        counter.mValue.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+BENCHMARK(BM_CounterHandWired)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_CounterSingle(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        borrow<CounterBench>().mValue.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+BENCHMARK(BM_CounterSingle)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_CounterSharded(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        ShardedCounterBench *counter = get{};
+
+        counter->mValue.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+BENCHMARK(BM_CounterSharded)->ThreadRange(1, 8)->UseRealTime();
+
+// unique pointer allocation
+static void BM_PoolHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        auto value = std::make_unique<PoolBench>();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_PoolHandWired);
+
+static void BM_PoolMalloc(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        std::unique_ptr<PoolBench> value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_PoolMalloc);
+
+static void BM_PoolUnique(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        pool_ptr<PoolBench> value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_PoolUnique);
+
+// recycled instances
+static void BM_CodecHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        auto value = std::make_unique<CodecBench>();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_CodecHandWired);
+
+static void BM_CodecUnique(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        std::unique_ptr<CodecBench> value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_CodecUnique);
+
+static void BM_CodecPooled(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        pooled_ptr<CodecBench> value = get{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_CodecPooled);
+
+// multiple binds
+template<int N>
+static void BM_AllHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        std::vector<AllBench<N> > values;
+
+        for (int i = 0; i < N; i++) {
+            values.push_back(AllBench<N>{});
+        }
+
+        benchmark::DoNotOptimize(values);
+    }
+}
+BENCHMARK_TEMPLATE(BM_AllHandWired, 8);
+BENCHMARK_TEMPLATE(BM_AllHandWired, 64);
+
+template<int N>
+static void BM_All(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        std::vector<AllBench<N> > values = all{};
+
+        benchmark::DoNotOptimize(values);
+    }
+}
+BENCHMARK_TEMPLATE(BM_All, 8);
+BENCHMARK_TEMPLATE(BM_All, 64);
+
+template<int N>
+static void BM_AllViewFirst(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        auto view = all_view<AllBench<N> >{};
+
+        benchmark::DoNotOptimize(*view.begin());
+    }
+}
+BENCHMARK_TEMPLATE(BM_AllViewFirst, 8);
+BENCHMARK_TEMPLATE(BM_AllViewFirst, 64);
+
+// named and typed values
+static void BM_NamedHandWired(benchmark::State &state) {
+    static std::string const value = "https://google.com";
+
+    for (auto _: state) {
+        std::string_view view = value;
+
+        benchmark::DoNotOptimize(view);
+    }
+}
+BENCHMARK(BM_NamedHandWired);
+
+static void BM_NamedView(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        auto view = get_named<"bench.url">{}.get_view();
+
+        benchmark::DoNotOptimize(view);
+    }
+}
+BENCHMARK(BM_NamedView);
+
+static void BM_NamedMapped(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        auto view = get_named<"bench.mapped">{}.get_view();
+
+        benchmark::DoNotOptimize(view);
+    }
+}
+BENCHMARK(BM_NamedMapped);
+
+static void BM_NamedLoadFile(benchmark::State &state) {
+    auto path = std::filesystem::temp_directory_path()/"jinject_bench_load.conf";
+
+    {
+        std::ofstream file{path};
+
+        for (int i = 0; i < state.range(0); i++) {
+            file << "load.key" << i << " = value" << i << "\n";
+        }
+    }
+
+    for (auto _: state) {
+        details::named_file file{path.string()};
+
+        benchmark::DoNotOptimize(file.size());
+    }
+
+    state.SetItemsProcessed(state.iterations()*state.range(0));
+}
+BENCHMARK(BM_NamedLoadFile)->Arg(1000)->Arg(10000);
+
+static void BM_NamedString(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        std::string value = get_named<"bench.url">{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_NamedString);
+
+static void BM_NamedInt(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        auto value = get_named<"bench.timeout">{}.get_int();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_NamedInt);
+
+static void BM_TypedHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        std::string_view value = "Oi, bench !";
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_TypedHandWired);
+
+static void BM_TypedView(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        auto value = _TV("Hello, bench !", BENCH_PT_br);
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_TypedView);
+
+static void BM_TypedCurrentLocale(benchmark::State &state) {
+    LoadModules();
+
+    set_thread_locale(BENCH_PT_br);
+
+    for (auto _: state) {
+        auto value = _TV("Hello, bench !");
+
+        benchmark::DoNotOptimize(value);
+    }
+
+    set_thread_locale(CURRENT_LOCALE);
+}
+BENCHMARK(BM_TypedCurrentLocale);
+
+static void BM_TypedString(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        auto value = _T("Hello, bench !", BENCH_PT_br);
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_TypedString);
+
+// lazy
+static void BM_LazyHandWired(benchmark::State &state) {
+    static auto instance = std::make_shared<SingleBench>(42);
+
+    for (auto _: state) {
+        auto &value = instance;
+
+        benchmark::DoNotOptimize(value->mValue);
+    }
+}
+BENCHMARK(BM_LazyHandWired);
+
+static void BM_Lazy(benchmark::State &state) {
+    LoadModules();
+
+    lazy<std::shared_ptr<SingleBench> > value;
+
+    for (auto _: state) {
+        benchmark::DoNotOptimize(value()->mValue);
+    }
+}
+BENCHMARK(BM_Lazy);
+
+// optional resolution
+static void BM_InjectByHandWired(benchmark::State &state) {
+    for (auto _: state) {
+        std::expected<FactoryBench, std::string> value = FactoryBench{42};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_InjectByHandWired);
+
+static void BM_InjectByHit(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        auto value = inject_by<FactoryBench>();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_InjectByHit);
+
+static void BM_InjectByMiss(benchmark::State &state) {
+    for (auto _: state) {
+        auto value = inject_by<long>();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_InjectByMiss);
+
+static void BM_TryInjectMiss(benchmark::State &state) {
+    for (auto _: state) {
+        auto value = try_inject<long>();
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_TryInjectMiss);
+
+// service
+static void BM_ServiceHandWired(benchmark::State &state) {
+    static auto single = std::make_shared<SingleBench>(42);
+
+    for (auto _: state) {
+        auto value = std::make_unique<ServiceBench>(FactoryBench{42}, single);
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_ServiceHandWired);
+
+static void BM_Service(benchmark::State &state) {
+    LoadModules();
+
+    for (auto _: state) {
+        std::unique_ptr<ServiceBench> value = service<FactoryBench, std::shared_ptr<SingleBench> >{};
+
+        benchmark::DoNotOptimize(value);
+    }
+}
+BENCHMARK(BM_Service);
@@ -1,6 +1,11 @@
 #include "jinject/jinject.h"
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <latch>
+#include <numeric>
+#include <thread>
 
 #include <gtest/gtest.h>
 
@@ -66,6 +71,8 @@ private:
         NAMED("url", "https://google.com");
         NAMED("url2", "https://google.com/{}/{}");
         NAMED("value", 42);
+        NAMED("ratio", 0.5);
+        NAMED("timeout", " 1500");
     }
 
     void LoadTypedModule() {
@@ -208,6 +215,87 @@ TEST(InjectionSuite, NamedInt) {
     ASSERT_EQ(value, 42);
 }
 
+TEST(InjectionSuite, NamedTyped) {
+    ASSERT_EQ(get_named<"value">{}.get_long().value_or(-1), 42L);
+    ASSERT_EQ(get_named<"value">{}.get_double().value_or(-1.0), 42.0);
+    ASSERT_EQ(std::string{get_named<"value">{}}, "42");
+    ASSERT_EQ(get_named<"ratio">{}.get_double().value_or(-1.0), 0.5);
+    ASSERT_EQ(get_named<"ratio">{}.get_int().value_or(-1), 0);
+    ASSERT_EQ(get_named<"timeout">{}.get_int().value_or(-1), 1500);
+    ASSERT_FALSE(get_named<"url">{}.get_int());
+    ASSERT_FALSE(get_named<"jeff">{}.get_double());
+}
+
+TEST(InjectionSuite, NamedView) {
+    auto named = get_named<"url">{};
+
+    ASSERT_EQ(named.get_view(), "https://google.com");
+    ASSERT_EQ(named.get_view().data(), get_named<"url">{}.get_view().data());
+    ASSERT_EQ(get_named<"jeff">{"none"}.get_view(), "none");
+}
+
+TEST(InjectionSuite, NamedLateRegistration) {
+    ASSERT_FALSE(get_named<"late">{}.get_string());
+
+    NAMED("late", "value");
+
+    ASSERT_EQ(get_named<"late">{}.get_view(), "value");
+}
+
+TEST(InjectionSuite, NamedFile) {
+    auto path = std::filesystem::temp_directory_path()/"jinject_named_file.conf";
+
+    std::ofstream{path} <<
+        "# service configuration\n"
+        "url = https://example.com\n"
+        "export file.retries=3\n"
+        "file.name = \"quoted value\"\n"
+        "file.name = \"last value\"\n"
+        "\n"
+        "[file.server]\r\n"
+        "; comment\n"
+        "port = 8080\n"
+        "ratio = 0.25";
+
+    ASSERT_EQ(load_named(path.string()), 5u);
+
+    ASSERT_EQ(get_named<"url">{}.get_view(), "https://google.com");
+    ASSERT_EQ(get_named<"file.retries">{}.get_int().value(), 3);
+    ASSERT_EQ(get_named<"file.name">{}.get_view(), "last value");
+    ASSERT_EQ(get_named<"file.server.port">{}.get_int().value(), 8080);
+    ASSERT_EQ(get_named<"file.server.ratio">{}.get_double().value(), 0.25);
+    ASSERT_FALSE(get_named<"port">{}.get_string());
+
+    std::filesystem::remove(path);
+
+    ASSERT_THROW(load_named(path.string()), std::runtime_error);
+}
+
+TEST(InjectionSuite, NamedFilePrecedence) {
+    auto first = std::filesystem::temp_directory_path()/"jinject_named_first.conf";
+    auto second = std::filesystem::temp_directory_path()/"jinject_named_second.conf";
+
+    std::ofstream{first} << "precedence.value = first\n";
+    std::ofstream{second} << "precedence.value = second\n";
+
+    ASSERT_FALSE(get_named<"precedence.value">{}.get_string());
+
+    load_named(first.string());
+
+    ASSERT_EQ(get_named<"precedence.value">{}.get_view(), "first");
+
+    load_named(second.string());
+
+    ASSERT_EQ(get_named<"precedence.value">{}.get_view(), "second");
+
+    NAMED("precedence.value", "named");
+
+    ASSERT_EQ(get_named<"precedence.value">{}.get_view(), "named");
+
+    std::filesystem::remove(first);
+    std::filesystem::remove(second);
+}
+
 // typed tests
 TEST(InjectionSuite, Typed) {
     ASSERT_EQ(_T("Hello, world !"), "Hello, world !");
@@ -215,6 +303,29 @@ TEST(InjectionSuite, Typed) {
     ASSERT_EQ(_T("Hello, world !", ES_es), "Holla, mundo !");
 }
 
+TEST(InjectionSuite, TypedLocale) {
+    ASSERT_EQ(_TV("Hello, world !"), "Hello, world !");
+
+    set_locale(PT_br);
+
+    ASSERT_EQ(_TV("Hello, world !"), "Oi, mundo !");
+    ASSERT_EQ(_T("Hello, world !", ORIGINAL_LOCALE), "Hello, world !");
+
+    std::thread{
+        []() {
+            set_thread_locale(ES_es);
+
+            ASSERT_EQ(_T("Hello, world !"), "Holla, mundo !");
+        }
+    }.join();
+
+    ASSERT_EQ(_T("Hello, world !"), "Oi, mundo !");
+
+    set_locale(ORIGINAL_LOCALE);
+
+    ASSERT_EQ(_TV("Hello, world !"), "Hello, world !");
+}
+
 // primitive tests
 TEST(InjectionSuite, Primitive) {
     int value = get{};
@@ -303,6 +414,149 @@ TEST(InjectionSuite, SharedSingleInstantiation) {
     SUCCEED();
 }
 
+TEST(InjectionSuite, BorrowSingleInstantiation) {
+    std::shared_ptr<SingleInstantiation> shared = get{};
+    SingleInstantiation &value = borrow<SingleInstantiation>();
+
+    ASSERT_EQ(&value, shared.get());
+    ASSERT_EQ(shared.use_count(), 2);
+    ASSERT_THROW(borrow<UndefinedInstantiation>(), std::runtime_error);
+}
+
+// deferred single instantiation
+struct DeferredInstantiation {
+    DeferredInstantiation() {
+        instances++;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    inline static std::atomic<int> instances{0};
+};
+
+TEST(InjectionSuite, DeferredSingleInstantiation) {
+    DEFERRED_SINGLE(std::shared_ptr<DeferredInstantiation>) {
+        return std::make_shared<DeferredInstantiation>();
+    };
+
+    ASSERT_EQ(DeferredInstantiation::instances, 0);
+
+    std::latch start{4};
+    std::vector<std::shared_ptr<DeferredInstantiation> > values(4);
+    std::vector<std::thread> threads;
+
+    for (auto &value: values) {
+        threads.emplace_back([&]() {
+            start.arrive_and_wait();
+
+            value = get{};
+        });
+    }
+
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(DeferredInstantiation::instances, 1);
+    ASSERT_EQ(values[0].get(), values[3].get());
+    ASSERT_EQ(&borrow<DeferredInstantiation>(), values[0].get());
+}
+
+// warmup
+struct WarmupConfig {
+    WarmupConfig() {
+        instances++;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+
+    inline static std::atomic<int> instances{0};
+};
+
+struct WarmupDatabase {
+    WarmupDatabase(std::shared_ptr<WarmupConfig> config) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+};
+
+struct WarmupCache {
+    WarmupCache(std::shared_ptr<WarmupConfig> config) {
+    }
+};
+
+TEST(InjectionSuite, Warmup) {
+    warmup startup;
+
+    SINGLE(WarmupDatabase*) {
+        return new WarmupDatabase{inject<std::shared_ptr<WarmupConfig> >()};
+    };
+
+    SINGLE(WarmupCache*) {
+        return new WarmupCache{inject<std::shared_ptr<WarmupConfig> >()};
+    };
+
+    SINGLE(std::shared_ptr<WarmupConfig>) {
+        return std::make_shared<WarmupConfig>();
+    };
+
+    ASSERT_EQ(WarmupConfig::instances, 0);
+
+    auto report = startup.run(4);
+
+    ASSERT_EQ(WarmupConfig::instances, 1);
+    ASSERT_EQ(report.nodes.size(), 3);
+    ASSERT_EQ(report.critical_path.size(), 2);
+    ASSERT_EQ(report.nodes[report.critical_path[0]].name, "WarmupDatabase*");
+    ASSERT_EQ(report.nodes[report.critical_path[1]].name, "std::shared_ptr<WarmupConfig>");
+    ASSERT_GE(report.critical_time, std::chrono::milliseconds(40));
+
+    WarmupDatabase *database1 = get{};
+    WarmupDatabase *database2 = get{};
+
+    ASSERT_EQ(database1, database2);
+    ASSERT_EQ(WarmupConfig::instances, 1);
+}
+
+struct WarmupCycleA {
+};
+
+struct WarmupCycleB {
+};
+
+static std::atomic<int> warmupCycleBuilds{0};
+
+static void WarmupCycleRendezvous() {
+    warmupCycleBuilds++;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+    while (warmupCycleBuilds < 2 and std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+}
+
+TEST(InjectionSuite, WarmupCycle) {
+    warmup startup;
+
+    SINGLE(WarmupCycleA*) {
+        WarmupCycleRendezvous();
+
+        WarmupCycleB *b = get{};
+
+        return new WarmupCycleA{};
+    };
+
+    SINGLE(WarmupCycleB*) {
+        WarmupCycleRendezvous();
+
+        WarmupCycleA *a = get{};
+
+        return new WarmupCycleB{};
+    };
+
+    ASSERT_THROW(startup.run(2), std::runtime_error);
+}
+
 // undefined instatiation
 TEST(InjectionSuite, UndefinedInstatiation) {
     try {
@@ -354,6 +608,93 @@ TEST(InjectionSuite, UniqueInstatiation) {
     }
 }
 
+// pool instantiation
+struct PoolInstantiation {
+    int mValue{0};
+};
+
+TEST(InjectionSuite, PoolUniqueInstantiation) {
+    POOL_UNIQUE(PoolInstantiation) {
+        return PoolInstantiation{42};
+    };
+
+    auto before = pool_stats<PoolInstantiation>();
+    PoolInstantiation *address;
+
+    {
+        pool_ptr<PoolInstantiation> value = get{};
+
+        ASSERT_EQ(value->mValue, 42);
+
+        address = value.get();
+    }
+
+    pool_ptr<PoolInstantiation> value = get{};
+
+    ASSERT_EQ(value.get(), address);
+
+    auto after = pool_stats<PoolInstantiation>();
+
+    ASSERT_EQ(after.allocations - before.allocations, 1);
+    ASSERT_EQ(after.reuses - before.reuses, 1);
+    ASSERT_EQ(after.releases - before.releases, 1);
+}
+
+// pooled instantiation
+struct PooledInstantiation {
+    void reset() {
+        mValue = 0;
+        resets++;
+    }
+
+    int mValue{0};
+
+    inline static int constructions{0};
+    inline static int resets{0};
+};
+
+TEST(InjectionSuite, PooledInstantiation) {
+    POOLED(PooledInstantiation) {
+        PooledInstantiation::constructions++;
+
+        return PooledInstantiation{42};
+    };
+
+    auto before = pooled_stats<PooledInstantiation>();
+    PooledInstantiation *address;
+
+    {
+        pooled_ptr<PooledInstantiation> value = get{};
+
+        ASSERT_EQ(value->mValue, 42);
+
+        value->mValue = 21;
+        address = value.get();
+    }
+
+    ASSERT_EQ(PooledInstantiation::resets, 1);
+
+    pooled_ptr<PooledInstantiation> value = get{};
+
+    ASSERT_EQ(value.get(), address);
+    ASSERT_EQ(value->mValue, 0);
+    ASSERT_EQ(PooledInstantiation::constructions, 1);
+
+    {
+        pooled_ptr<PooledInstantiation> other1 = get{};
+        pooled_ptr<PooledInstantiation> other2 = get{};
+    }
+
+    auto after = pooled_stats<PooledInstantiation>();
+
+    ASSERT_EQ(PooledInstantiation::constructions, 3);
+    ASSERT_EQ(after.allocations - before.allocations, 3u);
+    ASSERT_EQ(after.reuses - before.reuses, 1u);
+    ASSERT_EQ(after.releases - before.releases, 3u);
+    ASSERT_EQ(after.cached, 2u);
+    ASSERT_GE(after.high_water, 2u);
+}
+
 // shared instatiation
 TEST(InjectionSuite, SharedInstantiation) {
     std::shared_ptr<SharedInstantiation> value = get{};
@@ -372,6 +713,264 @@ TEST(InjectionSuite, SharedInstantiationCompared) {
     SUCCEED();
 }
 
+struct ConcurrentSharedInstantiation {
+    ConcurrentSharedInstantiation() {
+        instances++;
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    inline static std::atomic<int> instances{0};
+};
+
+TEST(InjectionSuite, SharedInstantiationConcurrent) {
+    SHARED(ConcurrentSharedInstantiation) {
+        return new ConcurrentSharedInstantiation{};
+    };
+
+    std::latch start{8};
+    std::vector<std::shared_ptr<ConcurrentSharedInstantiation> > values(8);
+    std::vector<std::thread> threads;
+
+    for (auto &value: values) {
+        threads.emplace_back([&]() {
+            start.arrive_and_wait();
+
+            value = get{};
+        });
+    }
+
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    for (auto &value: values) {
+        ASSERT_EQ(value.get(), values[0].get());
+    }
+
+    ASSERT_EQ(ConcurrentSharedInstantiation::instances, 1);
+
+    values.clear();
+
+    std::shared_ptr<ConcurrentSharedInstantiation> value = get{};
+
+    ASSERT_EQ(ConcurrentSharedInstantiation::instances, 2);
+}
+
+struct MakeSharedInstantiation {
+    MakeSharedInstantiation(int value, std::string text): mValue{value} {
+    }
+
+    int mValue{0};
+};
+
+struct AllocatedSharedInstantiation {
+    int mValue{0};
+};
+
+TEST(InjectionSuite, MakeSharedInstantiation) {
+    MAKE_SHARED(MakeSharedInstantiation) {
+        return make(get{}, "Hello, world !");
+    };
+
+    std::shared_ptr<MakeSharedInstantiation> value1 = get{};
+    std::shared_ptr<MakeSharedInstantiation> value2 = get{};
+
+    ASSERT_EQ(value1->mValue, 42);
+    ASSERT_EQ(value1.get(), value2.get());
+}
+
+TEST(InjectionSuite, AllocatedSharedInstantiation) {
+    static char buffer[1024];
+    static std::pmr::monotonic_buffer_resource resource{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+    details::shared<AllocatedSharedInstantiation>{details::InternalType{}, &resource} = [](auto make) {
+        return make(42);
+    };
+
+    std::shared_ptr<AllocatedSharedInstantiation> value = get{};
+    auto address = reinterpret_cast<char *>(value.get());
+
+    ASSERT_EQ(value->mValue, 42);
+    ASSERT_TRUE(address >= buffer and address < buffer + sizeof(buffer));
+}
+
+// scoped instantiation
+struct ScopedInstantiation {
+    ScopedInstantiation(int value): mValue{value} {
+        instances++;
+    }
+
+    ~ScopedInstantiation() {
+        instances--;
+    }
+
+    int mValue{0};
+
+    inline static int instances{0};
+};
+
+TEST(InjectionSuite, ScopedInstantiation) {
+    SCOPED(ScopedInstantiation) {
+        return ScopedInstantiation{inject<int>()};
+    };
+
+    ASSERT_FALSE(try_inject<ScopedInstantiation *>());
+
+    {
+        scope request;
+
+        ScopedInstantiation *value1 = get{};
+        ScopedInstantiation *value2 = get{};
+
+        ASSERT_EQ(value1, value2);
+        ASSERT_EQ(value1->mValue, 42);
+        ASSERT_EQ(ScopedInstantiation::instances, 1);
+
+        {
+            scope child;
+
+            ScopedInstantiation *value3 = get{};
+
+            ASSERT_EQ(value1, value3);
+        }
+
+        ASSERT_EQ(ScopedInstantiation::instances, 1);
+    }
+
+    ASSERT_EQ(ScopedInstantiation::instances, 0);
+
+    {
+        scope request;
+
+        ScopedInstantiation *value = get{};
+
+        ASSERT_EQ(ScopedInstantiation::instances, 1);
+    }
+
+    ASSERT_EQ(ScopedInstantiation::instances, 0);
+}
+
+// thread local instantiation
+struct ThreadLocalInstantiation {
+    ThreadLocalInstantiation(int value): mValue{value} {
+        instances++;
+    }
+
+    ~ThreadLocalInstantiation() {
+        instances--;
+    }
+
+    int mValue{0};
+
+    inline static std::atomic<int> instances{0};
+};
+
+TEST(InjectionSuite, ThreadLocalInstantiation) {
+    THREAD_LOCAL(ThreadLocalInstantiation) {
+        return ThreadLocalInstantiation{inject<int>()};
+    };
+
+    ThreadLocalInstantiation *value1 = get{};
+    ThreadLocalInstantiation *value2 = get{};
+
+    ASSERT_EQ(value1, value2);
+    ASSERT_EQ(value1->mValue, 42);
+    ASSERT_EQ(ThreadLocalInstantiation::instances, 1);
+
+    ThreadLocalInstantiation *other = nullptr;
+
+    std::thread{
+        [&]() {
+            other = inject<ThreadLocalInstantiation *>();
+
+            EXPECT_EQ(ThreadLocalInstantiation::instances, 2);
+            EXPECT_EQ(other, inject<ThreadLocalInstantiation *>());
+        }
+    }.join();
+
+    ASSERT_NE(value1, other);
+    ASSERT_EQ(ThreadLocalInstantiation::instances, 1);
+}
+
+// sharded instantiation
+struct ShardedInstantiation {
+    std::atomic<int> mValue{0};
+};
+
+TEST(InjectionSuite, ShardedInstantiation) {
+    details::sharded<ShardedInstantiation>{details::InternalType{}, 3} = []() {
+        return ShardedInstantiation{};
+    };
+
+    std::vector<std::thread> workers;
+
+    for (int i = 0; i < 4; i++) {
+        workers.emplace_back([]() {
+            for (int j = 0; j < 1000; j++) {
+                ShardedInstantiation *shard = get{};
+
+                ASSERT_EQ(reinterpret_cast<std::uintptr_t>(shard) % 64, 0u);
+
+                shard->mValue++;
+            }
+        });
+    }
+
+    for (auto &worker: workers) {
+        worker.join();
+    }
+
+    int shards = 0;
+    int total = 0;
+
+    visit_shards<ShardedInstantiation>([&](ShardedInstantiation &shard) {
+        shards++;
+        total += shard.mValue;
+    });
+
+    ASSERT_EQ(shards, 4);
+    ASSERT_EQ(total, 4000);
+
+    ASSERT_THROW((visit_shards<ShardedInstantiation, SignatureType1>([](auto &) {})), std::runtime_error);
+}
+
+template<int N>
+struct ScopedSlot {
+    int mValue{N};
+};
+
+template<int... N>
+void LoadScopedModule(std::integer_sequence<int, N...>) {
+    ((SCOPED(ScopedSlot<N>) {
+        return ScopedSlot<N>{};
+    }), ...);
+}
+
+template<int... N>
+bool ResolveScopedModule(std::integer_sequence<int, N...>) {
+    return ((inject<ScopedSlot<N> *>()->mValue == N and inject<ScopedSlot<N> *>() == inject<ScopedSlot<N> *>()) and ...);
+}
+
+TEST(InjectionSuite, ScopedInstantiationSlots) {
+    using slots = std::make_integer_sequence<int, 64>;
+
+    LoadScopedModule(slots{});
+
+    scope request;
+
+    ScopedSlot<63> *last = get{};
+
+    {
+        scope child;
+
+        ASSERT_TRUE(ResolveScopedModule(slots{}));
+        ASSERT_EQ(last, inject<ScopedSlot<63> *>());
+    }
+
+    ASSERT_EQ(inject<ScopedSlot<0> *>()->mValue, 0);
+}
+
 // custom instatiation
 TEST(InjectionSuite, CustomInstantiation) {
     CustomInstantiation value1 = get<SignatureType1>{};
@@ -409,6 +1008,80 @@ TEST(InjectionSuite, MultipleBind) {
     ASSERT_EQ(binds[1], ptr2);
 }
 
+struct ViewInstantiation {
+    ViewInstantiation(int value): mValue{value} {
+        instances++;
+    }
+
+    int mValue{0};
+
+    inline static std::atomic<int> instances{0};
+};
+
+template<int... N>
+void LoadViewModule(std::integer_sequence<int, N...>) {
+    ((FACTORY(ViewInstantiation, std::integral_constant<int, N>) {
+        return ViewInstantiation{N};
+    }), ...);
+}
+
+TEST(InjectionSuite, MultipleBindView) {
+    LoadViewModule(std::make_integer_sequence<int, 8>{});
+
+    ViewInstantiation::instances = 0;
+
+    auto view = all_view<ViewInstantiation>{};
+    auto item = std::ranges::find_if(view,
+                                     [](auto &value) {
+                                         return value.mValue == 2;
+                                     });
+
+    ASSERT_NE(item, view.end());
+    ASSERT_EQ((*item).mValue, 2);
+    ASSERT_EQ(ViewInstantiation::instances, 3);
+
+    std::vector<ViewInstantiation> values = all{PARALLEL};
+
+    ASSERT_EQ(values.size(), 8);
+
+    for (int i = 0; i < 8; i++) {
+        ASSERT_EQ(values[i].mValue, i);
+    }
+}
+
+struct PriorityInstantiation {
+    int mValue{0};
+};
+
+template<>
+struct jinject::binding_priority<PriorityInstantiation, SignatureType2> : std::integral_constant<int, 10> {
+};
+
+TEST(InjectionSuite, MultipleBindPriority) {
+    FACTORY(PriorityInstantiation, SignatureType1) {
+        return PriorityInstantiation{1};
+    };
+
+    FACTORY(PriorityInstantiation, SignatureType2) {
+        return PriorityInstantiation{2};
+    };
+
+    try {
+        FACTORY(PriorityInstantiation, SignatureType1) {
+            return PriorityInstantiation{1};
+        };
+
+        FAIL();
+    } catch (...) {
+    }
+
+    std::vector<PriorityInstantiation> values = all{};
+
+    ASSERT_EQ(values.size(), 2);
+    ASSERT_EQ(values[0].mValue, 2);
+    ASSERT_EQ(values[1].mValue, 1);
+}
+
 // auto return
 TEST(InjectionSuite, AutoReturn) {
     decltype(auto) value = inject<int>();
@@ -435,6 +1108,185 @@ TEST(InjectionSuite, EmptyInjectWith) {
     ASSERT_EQ(value, 21L);
 }
 
+// async factory
+struct AsyncInstantiation {
+    std::thread::id mThread;
+};
+
+struct FailingAsyncInstantiation {
+};
+
+TEST(InjectionSuite, AsyncFactory) {
+    ASYNC_FACTORY(AsyncInstantiation) {
+        return AsyncInstantiation{std::this_thread::get_id()};
+    };
+
+    ASYNC_FACTORY(FailingAsyncInstantiation) {
+        throw std::runtime_error("unreachable daemon");
+    };
+
+    auto value = inject_async<AsyncInstantiation>();
+    auto failing = inject_async<FailingAsyncInstantiation>();
+
+    auto result = value.get();
+
+    ASSERT_TRUE(result);
+    ASSERT_NE(result->mThread, std::this_thread::get_id());
+    ASSERT_EQ(failing.get().error(), "unreachable daemon");
+
+    AsyncInstantiation local = inject<AsyncInstantiation>();
+
+    ASSERT_EQ(local.mThread, std::this_thread::get_id());
+
+    auto ready = inject_async<int>();
+
+    ASSERT_EQ(ready.wait_for(std::chrono::seconds{0}), std::future_status::ready);
+    ASSERT_EQ(ready.get().value(), 42);
+
+    ASSERT_FALSE(inject_async<UndefinedInstantiation *>().get());
+}
+
+TEST(InjectionSuite, TryInject) {
+    ASSERT_EQ(try_inject<int>().value_or(21), 42);
+
+    auto value = try_inject<UndefinedInstantiation *>();
+
+    ASSERT_FALSE(value);
+    ASSERT_EQ(value.error().status, UNDEFINED_INSTANTIATION);
+    ASSERT_EQ(value.error().to_string(), "jinject::undefined instantiation of \"UndefinedInstantiation*\"");
+}
+
+TEST(InjectionSuite, Introspection) {
+    static_assert(introspection<int>::name() == "int");
+    static_assert(introspection<UndefinedInstantiation>::name() == "UndefinedInstantiation");
+
+    ASSERT_EQ(introspection<std::shared_ptr<int> >::to_string(), "std::shared_ptr<int>");
+}
+
+// metrics
+struct MetricsFactory {
+};
+
+struct MetricsShared {
+};
+
+TEST(InjectionSuite, Metrics) {
+    FACTORY(MetricsFactory, SignatureType1) {
+        return MetricsFactory{};
+    };
+
+    SHARED(MetricsShared) {
+        return new MetricsShared{};
+    };
+
+    for (int i = 0; i < 3; i++) {
+        MetricsFactory factory = get<SignatureType1>{};
+    }
+
+    {
+        std::shared_ptr<MetricsShared> shared1 = get{};
+        std::shared_ptr<MetricsShared> shared2 = get{};
+    }
+
+    std::thread{
+        []() {
+            MetricsFactory factory = get<SignatureType1>{};
+        }
+    }.join();
+
+    auto factory = metrics_of<MetricsFactory, SignatureType1>();
+    auto shared = metrics_of<std::shared_ptr<MetricsShared> >();
+
+    if constexpr (!metrics_enabled) {
+        ASSERT_EQ(factory.resolutions, 0u);
+        ASSERT_TRUE(metrics().empty());
+
+        return;
+    }
+
+    ASSERT_EQ(factory.type, "MetricsFactory");
+    ASSERT_EQ(factory.signature, "SignatureType1");
+    ASSERT_EQ(factory.resolutions, 4u);
+    ASSERT_EQ(factory.constructions, 4u);
+    ASSERT_EQ(std::accumulate(factory.latency.begin(), factory.latency.end(), std::size_t{0}), 4u);
+
+    ASSERT_EQ(shared.resolutions, 2u);
+    ASSERT_EQ(shared.constructions, 1u);
+
+    ASSERT_TRUE(std::ranges::any_of(metrics(), [](auto const &binding) {
+        return binding.type == "MetricsFactory" and binding.signature == "SignatureType1";
+    }));
+}
+
+// trace
+struct TraceLeaf {
+};
+
+struct TraceRoot {
+    TraceLeaf mLeaf;
+};
+
+TEST(InjectionSuite, Trace) {
+    FACTORY(TraceLeaf) {
+        return TraceLeaf{};
+    };
+
+    FACTORY(TraceRoot, SignatureType1) {
+        return TraceRoot{inject<TraceLeaf>()};
+    };
+
+    trace profile;
+
+    TraceRoot root = get<SignatureType1>{};
+
+    auto report = profile.stop();
+
+    if constexpr (!trace_enabled) {
+        ASSERT_TRUE(report.events.empty());
+
+        return;
+    }
+
+    ASSERT_EQ(report.events.size(), 2u);
+    ASSERT_EQ(report.events[0].name, "TraceRoot [SignatureType1]");
+    ASSERT_EQ(report.events[0].parent, trace_report::npos);
+    ASSERT_EQ(report.events[1].name, "TraceLeaf");
+    ASSERT_EQ(report.events[1].parent, 0u);
+    ASSERT_GE(report.events[0].duration, report.events[1].duration);
+
+    ASSERT_NE(report.to_folded().find("TraceRoot [SignatureType1];TraceLeaf "), std::string::npos);
+    ASSERT_NE(report.to_chrome().find("\"name\":\"TraceLeaf\""), std::string::npos);
+
+    ASSERT_TRUE(profile.stop().events.empty());
+}
+
+// static module
+struct StaticModule : static_module<
+        static_factory<int, []() { return 42; }>,
+        static_factory<CustomInstantiation, []() { return CustomInstantiation{1}; }, SignatureType1>,
+        static_factory<NoDefaultConstructor, [](auto get) { return NoDefaultConstructor{get, "Hello, world !"}; }>,
+        static_single<SingleInstantiation *, []() { return new SingleInstantiation{}; }>
+    > {
+};
+
+TEST(InjectionSuite, StaticModule) {
+    static_assert(StaticModule::contains<int>);
+    static_assert(not StaticModule::contains<long>);
+    static_assert(not StaticModule::contains<CustomInstantiation>);
+
+    int value = get_from<StaticModule>{};
+    CustomInstantiation custom = get_from<StaticModule, SignatureType1>{};
+    NoDefaultConstructor noDefault = get_from<StaticModule>{};
+
+    ASSERT_EQ(value, 42);
+    ASSERT_EQ(custom.mValue, 1);
+    SingleInstantiation *single1 = get_from<StaticModule>{};
+    SingleInstantiation *single2 = get_from<StaticModule>{};
+
+    ASSERT_EQ(single1, single2);
+    ASSERT_EQ((inject_from<StaticModule, int>()), 42);
+}
+
 // lazy
 TEST(InjectionSuite, LazyUndefinedInstantiation) {
     try {
@@ -472,6 +1324,40 @@ TEST(InjectionSuite, LazySharedInstantiation) {
     }
 }
 
+TEST(InjectionSuite, LazyMovable) {
+    std::vector<lazy<std::shared_ptr<SharedInstantiation> > > lazies(2);
+
+    auto value = lazies[0]().get();
+
+    lazies.emplace_back();
+    lazies.push_back(std::move(lazies[0]));
+
+    ASSERT_EQ(lazies[3]().get(), value);
+    ASSERT_EQ(lazies[3].get(), &lazies[3]());
+    ASSERT_EQ(lazies[1]().get(), value);
+}
+
+TEST(InjectionSuite, LazyConcurrent) {
+    lazy<std::shared_ptr<SingleInstantiation> > lazyObj;
+    std::vector<std::thread> threads;
+    std::atomic<int> matches{0};
+    std::shared_ptr<SingleInstantiation> single = get{};
+
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&]() {
+            if (lazyObj().get() == single.get()) {
+                matches++;
+            }
+        });
+    }
+
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(matches, 4);
+}
+
 struct Interface {
     virtual int g() {
         return -1;
@@ -522,6 +1408,59 @@ TEST(InjectionSuite, CustomServiceInstantiation) {
     std::unique_ptr<CustomService> customService = service<std::unique_ptr<UniqueInstantiation>>{};
 }
 
+// concurrent registration
+template<int N>
+struct PluginInstantiation {
+    int mValue{N};
+};
+
+template<int... N>
+void LoadPluginModule(std::integer_sequence<int, N...>) {
+    ((FACTORY(PluginInstantiation<N>) {
+        return PluginInstantiation<N>{};
+    }), ...);
+}
+
+template<int... N>
+bool ResolvePluginModule(std::integer_sequence<int, N...>) {
+    return ([]() {
+        while (!inject_by<PluginInstantiation<N> >()) {
+            std::this_thread::yield();
+        }
+
+        return inject<PluginInstantiation<N> >().mValue == N;
+    }() && ...);
+}
+
+TEST(InjectionSuite, ConcurrentRegistration) {
+    using plugins = std::make_integer_sequence<int, 32>;
+
+    std::vector<std::thread> resolvers;
+    std::atomic<int> resolved{0};
+
+    for (int i = 0; i < 4; i++) {
+        resolvers.emplace_back([&]() {
+            if (ResolvePluginModule(plugins{})) {
+                resolved++;
+            }
+        });
+    }
+
+    std::thread loader{
+        []() {
+            LoadPluginModule(plugins{});
+        }
+    };
+
+    loader.join();
+
+    for (auto &resolver: resolvers) {
+        resolver.join();
+    }
+
+    ASSERT_EQ(resolved, 4);
+}
+
 int main(int argc, char *argv[]) {
     ::testing::InitGoogleTest(&argc, argv);
 